@@ -0,0 +1,132 @@
+/*
+File: archive_benchmark.cpp
+
+Copyright (c) 2018 Alexander DuPree
+
+This software is released as open source through the MIT License
+
+Authors: Alexander DuPree
+
+https://github.com/AlexanderJDupree/Python-Strings-for-CPP
+
+Description: Times a cold start, reloading a dictionary of random strings and
+             reading every value once. The baseline reads a length-prefixed
+             file and builds an SString per string, the archive is mapped
+             and its strings view the mapping.
+
+*/
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include <unistd.h>
+#include "sstring_archive.h"
+
+typedef std::chrono::steady_clock clock_type;
+
+static const char* stream_path = "/tmp/sstring_archive_benchmark.bin";
+static const char* archive_path = "/tmp/sstring_archive_benchmark.arc";
+
+// Writes each string as its length followed by its characters
+static void save_stream(const std::vector<SString>& strings)
+{
+    std::FILE* out = std::fopen(stream_path, "wb");
+    for (const SString& str : strings)
+    {
+        unsigned length = str.length();
+        std::fwrite(&length, sizeof(length), 1, out);
+        std::fwrite(str.begin(), 1, length, out);
+    }
+    std::fclose(out);
+}
+
+static std::size_t load_stream()
+{
+    std::vector<SString> strings;
+    std::vector<char> buffer;
+    std::FILE* in = std::fopen(stream_path, "rb");
+
+    unsigned length;
+    while (std::fread(&length, sizeof(length), 1, in) == 1)
+    {
+        buffer.resize(length + 1);
+        length = std::fread(buffer.data(), 1, length, in);
+        strings.push_back(SString(buffer.data(), length));
+    }
+    std::fclose(in);
+
+    std::size_t checksum = 0;
+    for (const SString& str : strings)
+    {
+        checksum += str.length() + (unsigned char)str[0];
+    }
+    return checksum;
+}
+
+static std::size_t load_archive()
+{
+    SStringArchive archive(archive_path);
+
+    std::size_t checksum = 0;
+    for (SStringArchive::size_type i = 0; i < archive.size(); ++i)
+    {
+        SString str = archive[i];
+        checksum += str.length() + (unsigned char)str[0];
+    }
+    return checksum;
+}
+
+// Returns the best milliseconds of 5 runs
+template <typename Load>
+static double time_load(Load load)
+{
+    double best = 0;
+    for (unsigned run = 0; run < 5; ++run)
+    {
+        clock_type::time_point start = clock_type::now();
+        std::size_t checksum = load();
+        std::chrono::duration<double, std::milli> elapsed = clock_type::now() - start;
+
+        double ms = elapsed.count() + (checksum == 1);
+        best = run == 0 || ms < best ? ms : best;
+    }
+    return best;
+}
+
+static void compare(unsigned count, unsigned max_length)
+{
+    std::vector<SString> strings;
+    for (unsigned i = 0; i < count; ++i)
+    {
+        SString str(1 + std::rand() % max_length, ' ');
+        for (unsigned j = 0; j < str.length(); ++j)
+        {
+            const_cast<char*>(str.begin())[j] = 'a' + std::rand() % 26;
+        }
+        strings.push_back(str);
+    }
+    save_stream(strings);
+    SStringArchive::save(archive_path, strings);
+
+    double stream_ms = time_load(load_stream);
+    double archive_ms = time_load(load_archive);
+
+    std::printf("%9u %7u %12.2f %12.2f\n", count, max_length, stream_ms, archive_ms);
+}
+
+int main()
+{
+    std::srand(2018);
+
+    std::printf("%9s %7s %12s %12s\n", "strings", "length", "stream ms", "archive ms");
+
+    compare(10000, 32);
+    compare(1000000, 32);
+    compare(100000, 1024);
+
+    unlink(stream_path);
+    unlink(archive_path);
+
+    return 0;
+}
@@ -0,0 +1,127 @@
+/*
+File: case_benchmark.cpp
+
+Copyright (c) 2018 Alexander DuPree
+
+This software is released as open source through the MIT License
+
+Authors: Alexander DuPree
+
+https://github.com/AlexanderJDupree/Python-Strings-for-CPP
+
+Description: Looks up mixed case HTTP header names, comparing lowercasing a
+             copy of every key before comparing or hashing it against the
+             case-insensitive SString comparisons and functors.
+
+*/
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <unordered_map>
+#include <vector>
+#include "sstring.h"
+
+typedef std::chrono::steady_clock clock_type;
+
+static const char* names[] = {
+    "Accept", "Accept-Encoding", "Accept-Language", "Authorization",
+    "Cache-Control", "Connection", "Content-Length", "Content-Type", "Cookie",
+    "Host", "If-Modified-Since", "If-None-Match", "Origin", "Referer",
+    "User-Agent", "X-Forwarded-For", "X-Request-Id"
+};
+
+static SString lowercased(const SString& str)
+{
+    SString copy(str.begin(), str.length());
+    for (unsigned i = 0; i < copy.length(); ++i)
+    {
+        char c = copy.begin()[i];
+        const_cast<char*>(copy.begin())[i] = c >= 'A' && c <= 'Z' ? c + 32 : c;
+    }
+    return copy;
+}
+
+// Returns the best nanoseconds per lookup of 5 runs
+template <typename Lookup>
+static double time_lookups(std::size_t lookups, Lookup lookup)
+{
+    double best = 0;
+    for (unsigned run = 0; run < 5; ++run)
+    {
+        clock_type::time_point start = clock_type::now();
+        std::size_t checksum = lookup();
+        std::chrono::duration<double, std::nano> elapsed = clock_type::now() - start;
+
+        double ns = elapsed.count() / lookups + (checksum == 1);
+        best = run == 0 || ns < best ? ns : best;
+    }
+    return best;
+}
+
+int main()
+{
+    std::srand(2018);
+
+    const unsigned count = sizeof(names) / sizeof(names[0]);
+    std::vector<SString> keys;
+    for (unsigned i = 0; i < 200000; ++i)
+    {
+        SString key(names[std::rand() % count]);
+        for (unsigned j = 0; j < key.length(); ++j)
+        {
+            char c = key.begin()[j];
+            bool flip = std::rand() % 2 && ((c | 32) >= 'a' && (c | 32) <= 'z');
+            const_cast<char*>(key.begin())[j] = flip ? c ^ 32 : c;
+        }
+        keys.push_back(key);
+    }
+
+    std::unordered_map<SString, int> lowered;
+    std::unordered_map<SString, int, SString::ci_hash, SString::ci_equal> folded;
+    for (unsigned i = 0; i < count; ++i)
+    {
+        lowered[lowercased(names[i])] = i;
+        folded[names[i]] = i;
+    }
+    SString target("content-type");
+
+    double lower_equal_ns = time_lookups(keys.size(), [&]() {
+        std::size_t hits = 0;
+        for (const SString& key : keys)
+        {
+            hits += lowercased(key) == target;
+        }
+        return hits;
+    });
+    double equals_ci_ns = time_lookups(keys.size(), [&]() {
+        std::size_t hits = 0;
+        for (const SString& key : keys)
+        {
+            hits += key.equals_ci(target);
+        }
+        return hits;
+    });
+    double lower_map_ns = time_lookups(keys.size(), [&]() {
+        std::size_t sum = 0;
+        for (const SString& key : keys)
+        {
+            sum += lowered.find(lowercased(key))->second;
+        }
+        return sum;
+    });
+    double ci_map_ns = time_lookups(keys.size(), [&]() {
+        std::size_t sum = 0;
+        for (const SString& key : keys)
+        {
+            sum += folded.find(key)->second;
+        }
+        return sum;
+    });
+
+    std::printf("%-24s %8s %8s\n", "ns per key", "lower()", "_ci");
+    std::printf("%-24s %8.1f %8.1f\n", "compare", lower_equal_ns, equals_ci_ns);
+    std::printf("%-24s %8.1f %8.1f\n", "unordered_map lookup", lower_map_ns, ci_map_ns);
+
+    return 0;
+}
@@ -0,0 +1,147 @@
+/*
+File: check_benchmark.cpp
+
+Copyright (c) 2018 Alexander DuPree
+
+This software is released as open source through the MIT License
+
+Authors: Alexander DuPree
+
+https://github.com/AlexanderJDupree/Python-Strings-for-CPP
+
+Description: Times indexing and null pointer handling in the checking mode
+             the library was built with, see src/sstring_check.h. Built as
+             check_benchmark, checked, and check_benchmark_unchecked with
+             SSTRING_UNCHECKED and NDEBUG.
+
+*/
+
+#include <chrono>
+#include <cstdio>
+#include <stdexcept>
+#include "sstring.h"
+
+typedef std::chrono::steady_clock clock_type;
+
+#ifdef SSTRING_UNCHECKED
+static const char* mode = "unchecked";
+#else
+static const char* mode = "checked";
+#endif
+
+// Detects a null pointer by throwing and catching, as len() used to
+static std::size_t throwing_len(const char* str)
+{
+    try
+    {
+        if (str == NULL)
+        {
+            throw std::invalid_argument("char pointer points to null");
+        }
+        return SString::len(str);
+    }
+    catch (const std::invalid_argument&)
+    {
+        return 0;
+    }
+}
+
+// Returns the best nanoseconds per operation of 5 runs
+template <typename Operation>
+static double time_operations(std::size_t operations, Operation operation)
+{
+    double best = 0;
+    for (unsigned run = 0; run < 5; ++run)
+    {
+        clock_type::time_point start = clock_type::now();
+        std::size_t checksum = operation();
+        std::chrono::duration<double, std::nano> elapsed = clock_type::now() - start;
+
+        double ns = elapsed.count() / operations + (checksum == 1);
+        best = run == 0 || ns < best ? ns : best;
+    }
+    return best;
+}
+
+int main()
+{
+    const unsigned repeat = 2000;
+    SString str(4096, 'x');
+    const char* volatile null = NULL;
+
+    std::printf("ns per operation, %s\n", mode);
+
+    double index_ns = time_operations(repeat * str.length(), [&]() {
+        std::size_t sum = 0;
+        for (unsigned r = 0; r < repeat; ++r)
+        {
+            for (int i = 0; i < (int)str.length(); ++i)
+            {
+                sum += str[i];
+            }
+        }
+        return sum;
+    });
+    double try_at_ns = time_operations(repeat * str.length(), [&]() {
+        std::size_t sum = 0;
+        for (unsigned r = 0; r < repeat; ++r)
+        {
+            for (int i = 0; i < (int)str.length(); ++i)
+            {
+                sum += str.try_at(i).value_or(0);
+            }
+        }
+        return sum;
+    });
+    std::printf("%-34s %8.3f\n", "operator[]", index_ns);
+    std::printf("%-34s %8.3f\n", "try_at", try_at_ns);
+
+    double throwing_ns = time_operations(100000, [&]() {
+        std::size_t sum = 0;
+        for (unsigned i = 0; i < 100000; ++i)
+        {
+            sum += throwing_len(null);
+        }
+        return sum + 2;
+    });
+    double len_ns = time_operations(100000, [&]() {
+        std::size_t sum = 0;
+        for (unsigned i = 0; i < 100000; ++i)
+        {
+            sum += SString::len(null) + (str == null);
+        }
+        return sum + 2;
+    });
+    std::printf("%-34s %8.1f\n", "null len(), throwing and catching", throwing_ns);
+    std::printf("%-34s %8.1f\n", "null len() and ==", len_ns);
+
+#ifndef SSTRING_UNCHECKED
+    double catch_ns = time_operations(100000, [&]() {
+        std::size_t misses = 0;
+        for (unsigned i = 0; i < 100000; ++i)
+        {
+            try
+            {
+                misses += str[5000];
+            }
+            catch (const bad_index&)
+            {
+                ++misses;
+            }
+        }
+        return misses;
+    });
+    double miss_ns = time_operations(100000, [&]() {
+        std::size_t misses = 0;
+        for (unsigned i = 0; i < 100000; ++i)
+        {
+            misses += !str.try_at(5000);
+        }
+        return misses;
+    });
+    std::printf("%-34s %8.1f\n", "bad index, catching bad_index", catch_ns);
+    std::printf("%-34s %8.1f\n", "bad index, try_at", miss_ns);
+#endif
+
+    return 0;
+}
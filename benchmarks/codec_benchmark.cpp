@@ -0,0 +1,127 @@
+/*
+File: codec_benchmark.cpp
+
+Copyright (c) 2018 Alexander DuPree
+
+This software is released as open source through the MIT License
+
+Authors: Alexander DuPree
+
+https://github.com/AlexanderJDupree/Python-Strings-for-CPP
+
+Description: Encodes and decodes random buffers as hex and base64, comparing
+             byte at a time helpers appending to an std::string against the
+             SString codecs.
+
+*/
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include "sstring.h"
+
+typedef std::chrono::steady_clock clock_type;
+
+static const char b64_chars[] =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+static std::string naive_hex(const SString& bytes)
+{
+    std::string out;
+    for (unsigned char c : bytes)
+    {
+        out += "0123456789abcdef"[c >> 4];
+        out += "0123456789abcdef"[c & 15];
+    }
+    return out;
+}
+
+static std::string naive_b64(const SString& bytes)
+{
+    std::string out;
+    const unsigned char* in = (const unsigned char*)bytes.begin();
+    std::size_t n = bytes.length();
+    for (std::size_t i = 0; i < n; i += 3)
+    {
+        unsigned group = in[i] << 16;
+        group |= i + 1 < n ? in[i + 1] << 8 : 0;
+        group |= i + 2 < n ? in[i + 2] : 0;
+        out += b64_chars[group >> 18];
+        out += b64_chars[(group >> 12) & 63];
+        out += i + 1 < n ? b64_chars[(group >> 6) & 63] : '=';
+        out += i + 2 < n ? b64_chars[group & 63] : '=';
+    }
+    return out;
+}
+
+// Returns the best input bytes per nanosecond, GB/s, of 5 runs
+template <typename Codec>
+static double time_codec(std::size_t bytes, unsigned repeat, Codec codec)
+{
+    double best = 0;
+    for (unsigned run = 0; run < 5; ++run)
+    {
+        std::size_t checksum = 0;
+        clock_type::time_point start = clock_type::now();
+        for (unsigned i = 0; i < repeat; ++i)
+        {
+            checksum += codec();
+        }
+        std::chrono::duration<double, std::nano> elapsed = clock_type::now() - start;
+
+        double rate = bytes * repeat / elapsed.count() + (checksum == 1);
+        best = rate > best ? rate : best;
+    }
+    return best;
+}
+
+static void compare(std::size_t size, unsigned repeat)
+{
+    SString data(size, ' ');
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        const_cast<char*>(data.begin())[i] = std::rand() % 256;
+    }
+    SString hex = data.hex();
+    SString b64 = data.b64encode();
+
+    double naive_hex_rate = time_codec(size, repeat, [&data]() {
+        return naive_hex(data).size();
+    });
+    double hex_rate = time_codec(size, repeat, [&data]() {
+        return data.hex().length();
+    });
+    double fromhex_rate = time_codec(size, repeat, [&hex]() {
+        SString bytes;
+        return SString::fromhex(hex, bytes) + bytes.length();
+    });
+    double naive_b64_rate = time_codec(size, repeat, [&data]() {
+        return naive_b64(data).size();
+    });
+    double b64_rate = time_codec(size, repeat, [&data]() {
+        return data.b64encode().length();
+    });
+    double b64decode_rate = time_codec(size, repeat, [&b64]() {
+        SString bytes;
+        return SString::b64decode(b64, bytes) + bytes.length();
+    });
+
+    std::printf("%9zu %10.2f %8.2f %8.2f %10.2f %10.2f %10.2f\n", size,
+                naive_hex_rate, hex_rate, fromhex_rate, naive_b64_rate,
+                b64_rate, b64decode_rate);
+}
+
+int main()
+{
+    std::srand(2018);
+
+    std::printf("%9s %10s %8s %8s %10s %10s %10s\n", "GB/s", "naive hex",
+                "hex", "fromhex", "naive b64", "b64encode", "b64decode");
+
+    compare(64, 200000);
+    compare(1024, 20000);
+    compare(1 << 20, 20);
+
+    return 0;
+}
@@ -0,0 +1,122 @@
+/*
+File: crc32c_benchmark.cpp
+
+Copyright (c) 2018 Alexander DuPree
+
+This software is released as open source through the MIT License
+
+Authors: Alexander DuPree
+
+https://github.com/AlexanderJDupree/Python-Strings-for-CPP
+
+Description: Checksums strings of several lengths, comparing a byte at a time
+             CRC-32C table, the FNV-1a hash() and crc32c(), in GB/s.
+
+*/
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include "sstring.h"
+
+typedef std::chrono::steady_clock clock_type;
+
+// Returns the best GB/s of 5 runs checksumming bytes in total
+template <typename Checksum>
+static double time_bytes(std::size_t bytes, Checksum checksum)
+{
+    double best = 0;
+    for (unsigned run = 0; run < 5; ++run)
+    {
+        clock_type::time_point start = clock_type::now();
+        std::size_t sum = checksum();
+        std::chrono::duration<double, std::nano> elapsed = clock_type::now() - start;
+
+        double gbs = bytes / elapsed.count() + (sum == 1);
+        best = gbs > best ? gbs : best;
+    }
+    return best;
+}
+
+// The byte at a time checksum crc32c() replaces
+static std::uint32_t table_crc32c(const char* data, std::size_t n)
+{
+    static std::uint32_t table[256];
+    if (table[1] == 0)
+    {
+        for (std::uint32_t b = 0; b < 256; ++b)
+        {
+            std::uint32_t crc = b;
+            for (unsigned bit = 0; bit < 8; ++bit)
+            {
+                crc = (crc >> 1) ^ ((crc & 1) ? 0x82f63b78 : 0);
+            }
+            table[b] = crc;
+        }
+    }
+
+    std::uint32_t crc = ~0u;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        crc = (crc >> 8) ^ table[(crc ^ (unsigned char)data[i]) & 0xff];
+    }
+    return ~crc;
+}
+
+static void compare(std::size_t size, std::size_t total)
+{
+    std::vector<SString> strings;
+    for (std::size_t i = 0; i < total / size; ++i)
+    {
+        std::string chars(size, '\0');
+        for (char& c : chars)
+        {
+            c = 'a' + std::rand() % 26;
+        }
+        strings.push_back(SString(chars));
+    }
+    std::size_t bytes = strings.size() * size;
+
+    double table_gbs = time_bytes(bytes, [&]() {
+        std::size_t sum = 0;
+        for (const SString& str : strings)
+        {
+            sum += table_crc32c(str.begin(), str.length());
+        }
+        return sum;
+    });
+    double hash_gbs = time_bytes(bytes, [&]() {
+        std::size_t sum = 0;
+        for (const SString& str : strings)
+        {
+            sum += SString::hash(str.begin(), str.length());
+        }
+        return sum;
+    });
+    double crc32c_gbs = time_bytes(bytes, [&]() {
+        std::size_t sum = 0;
+        for (const SString& str : strings)
+        {
+            sum += str.crc32c();
+        }
+        return sum;
+    });
+
+    std::printf("%8zu %10.2f %10.2f %10.2f\n", size, table_gbs, hash_gbs, crc32c_gbs);
+}
+
+int main()
+{
+    std::srand(2018);
+
+    std::printf("%8s %10s %10s %10s\n", "chars", "table", "hash()", "crc32c()");
+
+    compare(16, 1 << 24);
+    compare(256, 1 << 24);
+    compare(4096, 1 << 24);
+    compare(1 << 20, 1 << 26);
+
+    return 0;
+}
@@ -0,0 +1,128 @@
+/*
+File: distance_benchmark.cpp
+
+Copyright (c) 2018 Alexander DuPree
+
+This software is released as open source through the MIT License
+
+Authors: Alexander DuPree
+
+https://github.com/AlexanderJDupree/Python-Strings-for-CPP
+
+Description: Scores a query against a catalog of random names, comparing a
+             dynamic programming edit distance filling the whole table
+             against Myers' bit-parallel levenshtein, unbounded and bounded.
+
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include "sstring_array.h"
+
+typedef std::chrono::steady_clock clock_type;
+
+static SString::size_type naive_levenshtein(const SString& a, const SString& b)
+{
+    std::vector<SString::size_type> row(b.length() + 1);
+    for (SString::size_type j = 0; j <= b.length(); ++j)
+    {
+        row[j] = j;
+    }
+
+    for (SString::size_type i = 1; i <= a.length(); ++i)
+    {
+        SString::size_type diagonal = row[0];
+        row[0] = i;
+        for (SString::size_type j = 1; j <= b.length(); ++j)
+        {
+            SString::size_type above = row[j];
+            row[j] = std::min({ row[j] + 1, row[j - 1] + 1,
+                                diagonal + (a.begin()[i - 1] != b.begin()[j - 1]) });
+            diagonal = above;
+        }
+    }
+
+    return row[b.length()];
+}
+
+// Returns the best nanoseconds per name of 5 runs
+template <typename Score>
+static double time_scores(std::size_t names, Score score)
+{
+    double best = 0;
+    for (unsigned run = 0; run < 5; ++run)
+    {
+        clock_type::time_point start = clock_type::now();
+        std::size_t checksum = score();
+        std::chrono::duration<double, std::nano> elapsed = clock_type::now() - start;
+
+        double ns = elapsed.count() / names + (checksum == 1);
+        best = run == 0 || ns < best ? ns : best;
+    }
+    return best;
+}
+
+static void compare(unsigned count, unsigned length)
+{
+    std::vector<SString> names;
+    for (unsigned i = 0; i < count; ++i)
+    {
+        SString name(length / 2 + std::rand() % length, ' ');
+        for (unsigned j = 0; j < name.length(); ++j)
+        {
+            const_cast<char*>(name.begin())[j] = 'a' + std::rand() % 26;
+        }
+        names.push_back(name);
+    }
+    SStringArray column(names);
+    SString query = names[count / 2];
+
+    double naive_ns = time_scores(count, [&]() {
+        std::size_t sum = 0;
+        for (const SString& name : names)
+        {
+            sum += naive_levenshtein(name, query);
+        }
+        return sum;
+    });
+    double myers_ns = time_scores(count, [&]() {
+        std::size_t sum = 0;
+        for (const SString& name : names)
+        {
+            sum += name.levenshtein(query);
+        }
+        return sum;
+    });
+    double bounded_ns = time_scores(count, [&]() {
+        std::size_t sum = 0;
+        for (const SString& name : names)
+        {
+            sum += name.levenshtein(query, 3);
+        }
+        return sum;
+    });
+    double batch_ns = time_scores(count, [&]() {
+        std::vector<SStringArray::size_type> scores = column.levenshtein(query);
+        return scores[0];
+    });
+
+    std::printf("%7u %7u %10.1f %10.1f %10.1f %10.1f\n", count, length,
+                naive_ns, myers_ns, bounded_ns, batch_ns);
+}
+
+int main()
+{
+    std::srand(2018);
+
+    std::printf("%7s %7s %10s %10s %10s %10s\n", "names", "length", "naive ns",
+                "myers ns", "max=3 ns", "batch ns");
+
+    compare(100000, 16);
+    compare(100000, 40);
+    compare(10000, 200);
+
+    return 0;
+}
@@ -0,0 +1,124 @@
+/*
+File: interop_benchmark.cpp
+
+Copyright (c) 2018 Alexander DuPree
+
+This software is released as open source through the MIT License
+
+Authors: Alexander DuPree
+
+https://github.com/AlexanderJDupree/Python-Strings-for-CPP
+
+Description: Passes strings between std::string, std::string_view and
+             SString, comparing the c-string conversions against the
+             overloads taking views and the adopting constructor. Built as
+             C++17.
+
+*/
+
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "sstring.h"
+
+typedef std::chrono::steady_clock clock_type;
+
+// Returns the best nanoseconds per operation of 5 runs
+template <typename Operation>
+static double time_operations(std::size_t operations, Operation operation)
+{
+    double best = 0;
+    for (unsigned run = 0; run < 5; ++run)
+    {
+        clock_type::time_point start = clock_type::now();
+        std::size_t checksum = operation();
+        std::chrono::duration<double, std::nano> elapsed = clock_type::now() - start;
+
+        double ns = elapsed.count() / operations + (checksum == 1);
+        best = run == 0 || ns < best ? ns : best;
+    }
+    return best;
+}
+
+static void compare(std::size_t size, unsigned count)
+{
+    std::vector<std::string> strings;
+    for (unsigned i = 0; i < count; ++i)
+    {
+        strings.push_back(std::string(size, 'a' + i % 26));
+    }
+    SString key(size, 'c');
+
+    double c_str_ns = time_operations(count, [&]() {
+        std::size_t sum = 0;
+        for (const std::string& str : strings)
+        {
+            sum += SString(str.c_str()).length();
+        }
+        return sum;
+    });
+    double string_ns = time_operations(count, [&]() {
+        std::size_t sum = 0;
+        for (const std::string& str : strings)
+        {
+            sum += SString(str).length();
+        }
+        return sum;
+    });
+    double compare_c_str_ns = time_operations(count, [&]() {
+        std::size_t sum = 0;
+        for (const std::string& str : strings)
+        {
+            sum += key == str.c_str();
+        }
+        return sum;
+    });
+    double compare_view_ns = time_operations(count, [&]() {
+        std::size_t sum = 0;
+        for (const std::string& str : strings)
+        {
+            sum += key == str;
+        }
+        return sum;
+    });
+    double copy_ns = time_operations(count, [&]() {
+        std::size_t sum = 0;
+        for (unsigned i = 0; i < count; ++i)
+        {
+            std::unique_ptr<char[]> buffer(new char[size + 1]);
+            std::memset(buffer.get(), 'x', size);
+            sum += SString(buffer.get(), size).length();
+        }
+        return sum;
+    });
+    double adopt_ns = time_operations(count, [&]() {
+        std::size_t sum = 0;
+        for (unsigned i = 0; i < count; ++i)
+        {
+            std::unique_ptr<char[]> buffer(new char[size + 1]);
+            std::memset(buffer.get(), 'x', size);
+            sum += SString(std::move(buffer), size).length();
+        }
+        return sum;
+    });
+
+    std::printf("%6zu %-22s %8.1f %8.1f\n", size, "construct", c_str_ns, string_ns);
+    std::printf("%6zu %-22s %8.1f %8.1f\n", size, "compare", compare_c_str_ns,
+                compare_view_ns);
+    std::printf("%6zu %-22s %8.1f %8.1f\n", size, "buffer copy vs adopt",
+                copy_ns, adopt_ns);
+}
+
+int main()
+{
+    std::printf("%6s %-22s %8s %8s\n", "chars", "ns per string", "c_str()",
+                "direct");
+
+    compare(16, 200000);
+    compare(4096, 20000);
+
+    return 0;
+}
@@ -0,0 +1,77 @@
+/*
+File: literal_benchmark.cpp
+
+Copyright (c) 2018 Alexander DuPree
+
+This software is released as open source through the MIT License
+
+Authors: Alexander DuPree
+
+https://github.com/AlexanderJDupree/Python-Strings-for-CPP
+
+Description: Simulates startup code that builds a table of configuration keys,
+             comparing heap allocated SStrings against static literals.
+
+*/
+
+#include <chrono>
+#include <iostream>
+#include <vector>
+#include "sstring.h"
+
+#define CONFIG_KEYS(KEY)                                                      \
+    KEY("server.listen.address") KEY("server.listen.port")                    \
+    KEY("server.tls.certificate") KEY("server.tls.private_key")               \
+    KEY("logging.level") KEY("logging.format") KEY("logging.output.path")     \
+    KEY("cache.capacity") KEY("cache.eviction.policy") KEY("cache.ttl")       \
+    KEY("protocol.version") KEY("protocol.header.content_type")               \
+    KEY("protocol.header.user_agent") KEY("protocol.max_frame_size")          \
+    KEY("database.host") KEY("database.pool.size")
+
+#define HEAP_KEY(str) keys.push_back(SString(str));
+#define UDL_KEY(str) keys.push_back(str ## _ss);
+#define STATIC_KEY(str) keys.push_back(SSTRING_LITERAL(str));
+
+static const unsigned iterations = 20000;
+
+typedef std::chrono::steady_clock clock_type;
+
+template <typename Builder>
+double run(const char* name, Builder build)
+{
+    std::vector<SString> keys;
+    keys.reserve(64);
+
+    std::size_t checksum = 0;
+    clock_type::time_point start = clock_type::now();
+    for (unsigned i = 0; i < iterations; ++i)
+    {
+        keys.clear();
+        build(keys);
+        checksum += keys.back().hash();
+    }
+    std::chrono::duration<double, std::micro> elapsed = clock_type::now() - start;
+
+    double per_key = elapsed.count() * 1000 / (iterations * keys.size());
+    std::cout << name << ": " << elapsed.count() / iterations 
+              << " us per table, " << per_key << " ns per key"
+              << " (checksum " << checksum % 1000 << ")\n";
+    return per_key;
+}
+
+int main()
+{
+    double heap = run("SString(\"literal\")", [](std::vector<SString>& keys) {
+        CONFIG_KEYS(HEAP_KEY)
+    });
+    double udl = run("\"literal\"_ss      ", [](std::vector<SString>& keys) {
+        CONFIG_KEYS(UDL_KEY)
+    });
+    double fixed = run("SSTRING_LITERAL   ", [](std::vector<SString>& keys) {
+        CONFIG_KEYS(STATIC_KEY)
+    });
+
+    std::cout << "speedup: _ss " << heap / udl << "x, SSTRING_LITERAL " 
+              << heap / fixed << "x\n";
+    return 0;
+}
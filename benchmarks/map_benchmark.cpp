@@ -0,0 +1,101 @@
+/*
+File: map_benchmark.cpp
+
+Copyright (c) 2018 Alexander DuPree
+
+This software is released as open source through the MIT License
+
+Authors: Alexander DuPree
+
+https://github.com/AlexanderJDupree/Python-Strings-for-CPP
+
+Description: Looks up c-string keys, half of them present, in an SStringMap
+             and in an std::unordered_map<std::string, int>, which builds a
+             temporary std::string for every lookup.
+
+*/
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "sstring_map.h"
+
+typedef std::chrono::steady_clock clock_type;
+
+// Returns the best nanoseconds per lookup of 5 runs
+template <typename Lookup>
+static double time_lookups(const std::vector<std::string>& keys, Lookup lookup)
+{
+    double best = 0;
+    for (unsigned run = 0; run < 5; ++run)
+    {
+        std::size_t found = 0;
+        clock_type::time_point start = clock_type::now();
+        for (unsigned repeat = 0; repeat < 10; ++repeat)
+        {
+            for (const std::string& key : keys)
+            {
+                found += lookup(key.c_str());
+            }
+        }
+        std::chrono::duration<double, std::nano> elapsed = clock_type::now() - start;
+
+        double ns = elapsed.count() / (10 * keys.size()) + (found == 1);
+        best = run == 0 || ns < best ? ns : best;
+    }
+    return best;
+}
+
+static std::string random_key(unsigned length)
+{
+    std::string key(length, 'a');
+    for (unsigned i = 0; i < length; ++i)
+    {
+        key[i] = 'a' + std::rand() % 26;
+    }
+    return key;
+}
+
+static void compare(unsigned entries, unsigned length)
+{
+    SStringMap<int> map;
+    std::unordered_map<std::string, int> std_map;
+    std::vector<std::string> keys;
+
+    for (unsigned i = 0; i < entries; ++i)
+    {
+        std::string key = random_key(length);
+        map[key.c_str()] = i;
+        std_map[key] = i;
+        keys.push_back(key);
+        keys.push_back(random_key(length));
+    }
+
+    double std_ns = time_lookups(keys, [&std_map](const char* key) {
+        return std_map.count(key);
+    });
+    double sstring_ns = time_lookups(keys, [&map](const char* key) {
+        return map.count(key);
+    });
+
+    std::printf("%9u %7u %20.1f %14.1f\n", entries, length, std_ns, sstring_ns);
+}
+
+int main()
+{
+    std::srand(2018);
+
+    std::printf("%9s %7s %20s %14s\n", "entries", "length",
+                "unordered_map (ns)", "SStringMap (ns)");
+
+    compare(1000, 8);
+    compare(1000, 32);
+    compare(100000, 8);
+    compare(100000, 32);
+    compare(1000000, 16);
+
+    return 0;
+}
@@ -0,0 +1,113 @@
+/*
+File: matcher_benchmark.cpp
+
+Copyright (c) 2018 Alexander DuPree
+
+This software is released as open source through the MIT License
+
+Authors: Alexander DuPree
+
+https://github.com/AlexanderJDupree/Python-Strings-for-CPP
+
+Description: Checks log lines against a growing number of keywords, comparing
+             one search per keyword against a single SStringMatcher scan.
+
+*/
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <vector>
+#include "sstring_matcher.h"
+
+typedef std::chrono::steady_clock clock_type;
+
+static SString random_word(unsigned length)
+{
+    SString word(length, 'a');
+    char* out = const_cast<char*>(word.begin());
+    for (unsigned i = 0; i < length; ++i)
+    {
+        out[i] = 'a' + std::rand() % 26;
+    }
+    return word;
+}
+
+// One search per keyword, memchr to each candidate then memcmp
+static bool contains_naive(const SString& line, const std::vector<SString>& keywords)
+{
+    for (const SString& keyword : keywords)
+    {
+        const char* it = line.begin();
+        const char* last = line.end() - keyword.length() + 1;
+        while (it < last && (it = (const char*)std::memchr(it, keyword[0], last - it)))
+        {
+            if (std::memcmp(it, keyword.begin(), keyword.length()) == 0)
+            {
+                return true;
+            }
+            ++it;
+        }
+    }
+    return false;
+}
+
+template <typename Search>
+static double time_lines(const std::vector<SString>& lines, Search search)
+{
+    unsigned hits = 0;
+    clock_type::time_point start = clock_type::now();
+    for (unsigned repeat = 0; repeat < 5; ++repeat)
+    {
+        for (const SString& line : lines)
+        {
+            hits += search(line);
+        }
+    }
+    std::chrono::duration<double, std::nano> elapsed = clock_type::now() - start;
+    return elapsed.count() / (5 * lines.size()) + (hits == ~0u);
+}
+
+int main()
+{
+    std::srand(2018);
+
+    // Lines of random words, so keyword hits are rare and every search runs
+    // to the end of the line
+    std::vector<SString> lines;
+    for (unsigned i = 0; i < 20000; ++i)
+    {
+        std::vector<SString> words;
+        for (unsigned w = 0; w < 16; ++w)
+        {
+            words.push_back(random_word(3 + std::rand() % 6));
+        }
+        lines.push_back(SString(" ").join(words));
+    }
+
+    std::cout << "keywords   per keyword ns/line   matcher ns/line   states\n";
+    unsigned counts[] = { 1, 10, 100, 1000 };
+    for (unsigned count : counts)
+    {
+        std::vector<SString> keywords;
+        for (unsigned i = 0; i < count; ++i)
+        {
+            keywords.push_back(random_word(6 + std::rand() % 6));
+        }
+        SStringMatcher matcher(keywords);
+
+        double naive = time_lines(lines, [&keywords](const SString& line) {
+            return contains_naive(line, keywords);
+        });
+        double compiled = time_lines(lines, [&matcher](const SString& line) {
+            return matcher.contains(line);
+        });
+
+        std::printf("%8u %21.1f %17.1f %8zu\n", count, naive, compiled,
+                    matcher.states());
+    }
+
+    return 0;
+}
@@ -0,0 +1,101 @@
+/*
+File: partition_benchmark.cpp
+
+Copyright (c) 2018 Alexander DuPree
+
+This software is released as open source through the MIT License
+
+Authors: Alexander DuPree
+
+https://github.com/AlexanderJDupree/Python-Strings-for-CPP
+
+Description: Splits key=value and host:port pairs, comparing find() followed
+             by two copying substring() calls against partition().
+
+*/
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <tuple>
+#include <vector>
+#include "sstring.h"
+
+typedef std::chrono::steady_clock clock_type;
+
+// Returns the best nanoseconds per pair of 5 runs
+template <typename Split>
+static double time_pairs(const std::vector<SString>& pairs, Split split)
+{
+    double best = 0;
+    for (unsigned run = 0; run < 5; ++run)
+    {
+        std::size_t checksum = 0;
+        clock_type::time_point start = clock_type::now();
+        for (unsigned repeat = 0; repeat < 200; ++repeat)
+        {
+            for (const SString& pair : pairs)
+            {
+                checksum += split(pair);
+            }
+        }
+        std::chrono::duration<double, std::nano> elapsed = clock_type::now() - start;
+
+        double ns = elapsed.count() / (200 * pairs.size()) + (checksum == 1);
+        best = run == 0 || ns < best ? ns : best;
+    }
+    return best;
+}
+
+static SString random_word(unsigned length)
+{
+    SString word(length, 'a');
+    for (unsigned i = 0; i < length; ++i)
+    {
+        const_cast<char*>(word.begin())[i] = 'a' + std::rand() % 26;
+    }
+    return word;
+}
+
+static void compare(const char* name, const std::vector<SString>& pairs,
+                    const char* sep)
+{
+    double copying = time_pairs(pairs, [sep](const SString& pair) {
+        SString::size_type index = pair.find(sep);
+        SString key = pair.substring(0, index - 1);
+        SString value = pair.substring(index + 1, pair.length() - 1);
+        return key.length() + value.length();
+    });
+    double partitioned = time_pairs(pairs, [sep](const SString& pair) {
+        SString key, separator, value;
+        std::tie(key, separator, value) = pair.partition(sep);
+        return key.length() + value.length();
+    });
+
+    std::printf("%-22s %18.1f %18.1f\n", name, copying, partitioned);
+}
+
+int main()
+{
+    std::srand(2018);
+
+    std::vector<SString> settings;
+    std::vector<SString> addresses;
+    std::vector<SString> headers;
+    for (unsigned i = 0; i < 2000; ++i)
+    {
+        settings.push_back(random_word(4 + std::rand() % 12) + "=" + 
+                           random_word(1 + std::rand() % 20));
+        addresses.push_back(random_word(8 + std::rand() % 20) + ".example.com:" + 
+                            random_word(4));
+        headers.push_back(random_word(30 + std::rand() % 20) + ": " + 
+                          random_word(40 + std::rand() % 80));
+    }
+
+    std::printf("%-22s %18s %18s\n", "pairs", "find+substring ns", "partition ns");
+    compare("key=value", settings, "=");
+    compare("host:port", addresses, ":");
+    compare("long header: value", headers, ": ");
+
+    return 0;
+}
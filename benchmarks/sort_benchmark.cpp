@@ -0,0 +1,111 @@
+/*
+File: sort_benchmark.cpp
+
+Copyright (c) 2018 Alexander DuPree
+
+This software is released as open source through the MIT License
+
+Authors: Alexander DuPree
+
+https://github.com/AlexanderJDupree/Python-Strings-for-CPP
+
+Description: Sorts random keys, and keys sharing a long common prefix like
+             URLs or paths, with std::sort, std::stable_sort, sstring_sort
+             and sstring_stable_sort in both modes.
+
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+#include "sstring_sort.h"
+
+typedef std::chrono::steady_clock clock_type;
+
+// Returns the best milliseconds of 5 runs, each sorting a copy of keys
+template <typename Sort>
+static double time_sort(const std::vector<SString>& keys, Sort sort)
+{
+    double best = 0;
+    for (unsigned run = 0; run < 5; ++run)
+    {
+        std::vector<SString> copy(keys);
+
+        clock_type::time_point start = clock_type::now();
+        sort(copy);
+        std::chrono::duration<double, std::milli> elapsed = clock_type::now() - start;
+
+        best = run == 0 || elapsed.count() < best ? elapsed.count() : best;
+    }
+    return best;
+}
+
+// Returns n keys of a random prefix_length characters taken from a few
+// prefixes, followed by random_length random characters
+static std::vector<SString> random_keys(unsigned n, unsigned prefix_length,
+                                        unsigned random_length)
+{
+    std::vector<SString> prefixes;
+    for (unsigned i = 0; i < 4; ++i)
+    {
+        prefixes.push_back(SString(prefix_length, 'a' + i));
+    }
+
+    std::vector<SString> keys;
+    for (unsigned i = 0; i < n; ++i)
+    {
+        SString key = prefixes[std::rand() % 4] + SString(random_length, ' ');
+        for (unsigned j = prefix_length; j < key.length(); ++j)
+        {
+            const_cast<char*>(key.begin())[j] = 'a' + std::rand() % 26;
+        }
+        keys.push_back(key);
+    }
+
+    // Sorting scattered buffers is the case being measured, so the keys are
+    // shuffled away from their allocation order
+    std::shuffle(keys.begin(), keys.end(), std::mt19937(2018));
+    return keys;
+}
+
+static void compare(const char* name, const std::vector<SString>& keys)
+{
+    typedef std::vector<SString> keys_type;
+
+    double std_sort = time_sort(keys, [](keys_type& k) {
+        std::sort(k.begin(), k.end());
+    });
+    double std_stable = time_sort(keys, [](keys_type& k) {
+        std::stable_sort(k.begin(), k.end());
+    });
+    double sorted = time_sort(keys, [](keys_type& k) {
+        sstring_sort(k.begin(), k.end());
+    });
+    double stable = time_sort(keys, [](keys_type& k) {
+        sstring_stable_sort(k.begin(), k.end());
+    });
+    double parallel = time_sort(keys, [](keys_type& k) {
+        sstring_sort(k.begin(), k.end(), sstring_parallel);
+    });
+
+    std::printf("%-24s %10.1f %12.1f %13.1f %13.1f %10.1f\n", name, std_sort,
+                std_stable, sorted, stable, parallel);
+}
+
+int main()
+{
+    std::srand(2018);
+
+    std::printf("%-24s %10s %12s %13s %13s %10s\n", "keys (ms)", "std::sort",
+                "stable_sort", "sstring_sort", "stable (ss)", "parallel");
+
+    compare("100k random, 16", random_keys(100000, 0, 16));
+    compare("1M random, 16", random_keys(1000000, 0, 16));
+    compare("1M prefix 24, random 8", random_keys(1000000, 24, 8));
+    compare("4M random, 12", random_keys(4000000, 0, 12));
+
+    return 0;
+}
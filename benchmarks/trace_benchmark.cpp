@@ -0,0 +1,81 @@
+/*
+File: trace_benchmark.cpp
+
+Copyright (c) 2018 Alexander DuPree
+
+This software is released as open source through the MIT License
+
+Authors: Alexander DuPree
+
+https://github.com/AlexanderJDupree/Python-Strings-for-CPP
+
+Description: Measures the overhead of latency tracing at several sample rates
+             on a mix of traced operations, then prints the trace report.
+
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include "sstring.h"
+
+static const unsigned iterations = 200000;
+
+typedef std::chrono::steady_clock clock_type;
+
+static double run_once(unsigned rate)
+{
+    SStringTrace::set_sample_rate(rate);
+
+    SString key("  server.listen.address  ");
+    unsigned checksum = 0;
+
+    clock_type::time_point start = clock_type::now();
+    for (unsigned i = 0; i < iterations; ++i)
+    {
+        SString copy("  server.listen.address  ");
+        SString joined = copy + "=8080";
+        checksum += (joined == key) + joined.substring(2, 7).length();
+        checksum += copy.strip(' ').length();
+    }
+    std::chrono::duration<double, std::nano> elapsed = clock_type::now() - start;
+
+    SStringTrace::set_sample_rate(0);
+    return elapsed.count() / iterations + (checksum == 0);
+}
+
+// Returns the best of several runs to filter out scheduling noise
+static double run(unsigned rate)
+{
+    double best = run_once(rate);
+    for (unsigned i = 0; i < 4; ++i)
+    {
+        best = std::min(best, run_once(rate));
+    }
+
+    return best;
+}
+
+int main()
+{
+    // Warm up the allocator and calibrate the cycle counter before timing
+    run(0);
+    SStringTrace::ns_per_tick();
+
+    double baseline = run(0);
+    std::cout << "sampling off:       " << baseline << " ns per iteration\n";
+
+    unsigned rates[] = { 1024, 128, 16, 1 };
+    for (unsigned rate : rates)
+    {
+        double traced = run(rate);
+        std::cout << "sampling 1 in " << rate << ":" 
+                  << std::string(rate < 10 ? 4 : rate < 100 ? 3 : rate < 1000 ? 2 : 1, ' ')
+                  << traced << " ns per iteration, overhead " 
+                  << (traced / baseline - 1) * 100 << "%\n";
+    }
+
+    std::cout << '\n';
+    SStringTrace::report(std::cout);
+    return 0;
+}
@@ -0,0 +1,229 @@
+/*
+File: unicode_benchmark.cpp
+
+Copyright (c) 2018 Alexander DuPree
+
+This software is released as open source through the MIT License
+
+Authors: Alexander DuPree
+
+https://github.com/AlexanderJDupree/Python-Strings-for-CPP
+
+Description: Validates and transcodes mostly ASCII and mostly accented text,
+             comparing code point at a time helpers appending to standard
+             strings against the SString transcoders.
+
+*/
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include "sstring.h"
+
+typedef std::chrono::steady_clock clock_type;
+
+// Returns the length of the sequence at in, or 0 if it is malformed
+static std::size_t naive_sequence(const unsigned char* in, std::size_t n,
+                                  unsigned& code_point)
+{
+    unsigned char c = in[0];
+    std::size_t length = c < 0x80 ? 1 : c < 0xc2 ? 0 : c < 0xe0 ? 2
+                       : c < 0xf0 ? 3 : c < 0xf5 ? 4 : 0;
+    if (length == 0 || length > n)
+    {
+        return 0;
+    }
+
+    code_point = length == 1 ? c : c & (0x7f >> length);
+    for (std::size_t i = 1; i < length; ++i)
+    {
+        if ((in[i] & 0xc0) != 0x80)
+        {
+            return 0;
+        }
+        code_point = code_point << 6 | (in[i] & 0x3f);
+    }
+
+    static const unsigned smallest[] = { 0, 0, 0x80, 0x800, 0x10000 };
+    bool surrogate = code_point >= 0xd800 && code_point < 0xe000;
+    return code_point < smallest[length] || surrogate || code_point > 0x10ffff
+           ? 0 : length;
+}
+
+static bool naive_validate(const SString& str)
+{
+    const unsigned char* in = (const unsigned char*)str.begin();
+    std::size_t n = str.length();
+    unsigned code_point;
+    for (std::size_t i = 0, length; i < n; i += length)
+    {
+        length = naive_sequence(in + i, n - i, code_point);
+        if (length == 0)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+static std::u16string naive_encode_utf16(const SString& str)
+{
+    const unsigned char* in = (const unsigned char*)str.begin();
+    std::size_t n = str.length();
+    std::u16string out;
+    unsigned code_point;
+    for (std::size_t i = 0, length; i < n; i += length)
+    {
+        length = naive_sequence(in + i, n - i, code_point);
+        if (code_point >= 0x10000)
+        {
+            out += char16_t(0xd800 + ((code_point - 0x10000) >> 10));
+            out += char16_t(0xdc00 + (code_point & 0x3ff));
+        }
+        else
+        {
+            out += char16_t(code_point);
+        }
+    }
+    return out;
+}
+
+static void append_utf8(unsigned code_point, std::string& out)
+{
+    if (code_point < 0x80)
+    {
+        out += char(code_point);
+    }
+    else if (code_point < 0x800)
+    {
+        out += char(0xc0 | code_point >> 6);
+        out += char(0x80 | (code_point & 0x3f));
+    }
+    else if (code_point < 0x10000)
+    {
+        out += char(0xe0 | code_point >> 12);
+        out += char(0x80 | ((code_point >> 6) & 0x3f));
+        out += char(0x80 | (code_point & 0x3f));
+    }
+    else
+    {
+        out += char(0xf0 | code_point >> 18);
+        out += char(0x80 | ((code_point >> 12) & 0x3f));
+        out += char(0x80 | ((code_point >> 6) & 0x3f));
+        out += char(0x80 | (code_point & 0x3f));
+    }
+}
+
+static std::string naive_decode_utf16(const std::u16string& units)
+{
+    std::string out;
+    for (std::size_t i = 0; i < units.size(); ++i)
+    {
+        unsigned code_point = units[i];
+        if (code_point >= 0xd800 && code_point < 0xdc00)
+        {
+            code_point = 0x10000 + ((code_point - 0xd800) << 10 |
+                                    (units[++i] - 0xdc00));
+        }
+        append_utf8(code_point, out);
+    }
+    return out;
+}
+
+static std::string naive_from_latin1(const SString& bytes)
+{
+    std::string out;
+    for (unsigned char c : bytes)
+    {
+        append_utf8(c, out);
+    }
+    return out;
+}
+
+// Returns the best UTF-8 bytes per nanosecond, GB/s, of 5 runs
+template <typename Transcode>
+static double time_transcode(std::size_t bytes, unsigned repeat, Transcode transcode)
+{
+    double best = 0;
+    for (unsigned run = 0; run < 5; ++run)
+    {
+        std::size_t checksum = 0;
+        clock_type::time_point start = clock_type::now();
+        for (unsigned i = 0; i < repeat; ++i)
+        {
+            checksum += transcode();
+        }
+        std::chrono::duration<double, std::nano> elapsed = clock_type::now() - start;
+
+        double rate = bytes * repeat / elapsed.count() + (checksum == 1);
+        best = rate > best ? rate : best;
+    }
+    return best;
+}
+
+// Times text of size Latin-1 characters, one in every accented is past 0x7f
+static void compare(const char* name, std::size_t size, unsigned accented,
+                    unsigned repeat)
+{
+    SString latin1(size, ' ');
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        const_cast<char*>(latin1.begin())[i] = std::rand() % accented == 0
+            ? 0xc0 + std::rand() % 64 : 'a' + std::rand() % 26;
+    }
+    SString utf8 = SString::from_latin1(latin1);
+    std::u16string utf16;
+    utf8.encode_utf16(utf16);
+    std::size_t bytes = utf8.length();
+
+    double naive_validate_rate = time_transcode(bytes, repeat, [&]() {
+        return naive_validate(utf8);
+    });
+    double validate_rate = time_transcode(bytes, repeat, [&]() {
+        return utf8.validate_utf8();
+    });
+    double naive_latin1_rate = time_transcode(bytes, repeat, [&]() {
+        return naive_from_latin1(latin1).size();
+    });
+    double latin1_rate = time_transcode(bytes, repeat, [&]() {
+        return SString::from_latin1(latin1).length();
+    });
+    double naive_encode_rate = time_transcode(bytes, repeat, [&]() {
+        return naive_encode_utf16(utf8).size();
+    });
+    double encode_rate = time_transcode(bytes, repeat, [&]() {
+        std::u16string units;
+        return utf8.encode_utf16(units) + units.size();
+    });
+    double naive_decode_rate = time_transcode(bytes, repeat, [&]() {
+        return naive_decode_utf16(utf16).size();
+    });
+    double decode_rate = time_transcode(bytes, repeat, [&]() {
+        SString str;
+        return SString::decode_utf16(utf16.data(), utf16.size(), str) + str.length();
+    });
+
+    std::printf("%-14s %-10s %8.2f %8.2f\n", name, "validate",
+                naive_validate_rate, validate_rate);
+    std::printf("%-14s %-10s %8.2f %8.2f\n", name, "latin1",
+                naive_latin1_rate, latin1_rate);
+    std::printf("%-14s %-10s %8.2f %8.2f\n", name, "to utf16",
+                naive_encode_rate, encode_rate);
+    std::printf("%-14s %-10s %8.2f %8.2f\n", name, "from utf16",
+                naive_decode_rate, decode_rate);
+}
+
+int main()
+{
+    std::srand(2018);
+
+    std::printf("%-25s %8s %8s\n", "GB/s", "naive", "SString");
+
+    compare("ascii 1KB", 1024, 1000000, 20000);
+    compare("ascii 1MB", 1 << 20, 1000000, 20);
+    compare("1 in 8 1MB", 1 << 20, 8, 20);
+    compare("accented 1MB", 1 << 20, 1, 20);
+
+    return 0;
+}
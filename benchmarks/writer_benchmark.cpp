@@ -0,0 +1,106 @@
+/*
+File: writer_benchmark.cpp
+
+Copyright (c) 2018 Alexander DuPree
+
+This software is released as open source through the MIT License
+
+Authors: Alexander DuPree
+
+https://github.com/AlexanderJDupree/Python-Strings-for-CPP
+
+Description: Writes short and long lines to /dev/null, comparing an ofstream
+             given c-strings or SStrings, a write() per string and an
+             SStringWriter.
+
+*/
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+#include "sstring_writer.h"
+
+typedef std::chrono::steady_clock clock_type;
+
+// Returns the best nanoseconds per line of 5 runs
+template <typename Write>
+static double time_lines(std::size_t lines, Write write)
+{
+    double best = 0;
+    for (unsigned run = 0; run < 5; ++run)
+    {
+        clock_type::time_point start = clock_type::now();
+        write();
+        std::chrono::duration<double, std::nano> elapsed = clock_type::now() - start;
+
+        double ns = elapsed.count() / lines;
+        best = run == 0 || ns < best ? ns : best;
+    }
+    return best;
+}
+
+// Times count lines of min to max characters
+static void compare(std::size_t count, unsigned min, unsigned max,
+                    std::ofstream& stream, int fd)
+{
+    std::vector<SString> lines;
+    for (unsigned i = 0; i < count; ++i)
+    {
+        lines.push_back(SString(min + std::rand() % (max - min), 'a' + i % 26));
+    }
+    SString newline = "\n"_ss;
+
+    double c_str_ns = time_lines(lines.size(), [&]() {
+        for (const SString& line : lines)
+        {
+            stream << line.c_str() << '\n';
+        }
+        stream.flush();
+    });
+    double stream_ns = time_lines(lines.size(), [&]() {
+        for (const SString& line : lines)
+        {
+            stream << line << '\n';
+        }
+        stream.flush();
+    });
+    double syscall_ns = time_lines(lines.size(), [&]() {
+        for (const SString& line : lines)
+        {
+            ssize_t n = write(fd, line.begin(), line.length());
+            n += write(fd, "\n", 1);
+        }
+    });
+    double writer_ns = time_lines(lines.size(), [&]() {
+        SStringWriter writer(fd);
+        for (const SString& line : lines)
+        {
+            writer << line << newline;
+        }
+        writer.flush();
+    });
+
+    std::printf("%4u-%-5u %12.1f %12.1f %12.1f %12.1f\n", min, max, c_str_ns,
+                stream_ns, syscall_ns, writer_ns);
+}
+
+int main()
+{
+    std::srand(2018);
+
+    std::ofstream stream("/dev/null");
+    int fd = open("/dev/null", O_WRONLY);
+
+    std::printf("%-10s %12s %12s %12s %12s\n", "ns/line", "<< c_str()",
+                "<< SString", "write()", "SStringWriter");
+
+    compare(1000000, 8, 48, stream, fd);
+    compare(10000, 2048, 8192, stream, fd);
+
+    close(fd);
+    return 0;
+}
@@ -12,76 +12,134 @@ https://github.com/AlexanderJDupree/Python-Strings-for-CPP
 */
 
 
+#include <algorithm>
+#include <utility>
 #include "sstring.h"
+#include "sstring_matcher.h"
+#include "sstring_glob.h"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+const SString::size_type SString::npos;
+const SString::difference_type SString::omitted;
+
+// Viewed by default constructed and moved from strings. Immortal, so it is
+// never counted, written or released
+static char empty_string[1] = "";
+static SString::control_block empty_block = { 1, SString::immortal, 0 };
 
 /****** CONSTRUCTORS ******/
 
 SString::SString()
-    : reference_manager(1)
-{
-    _data[0] = '\0';
-}
+    : reference_manager(empty_string, &empty_block), _str(_data), _length(0) {}
 
 SString::SString(const_pointer str) 
-    : reference_manager(len(str) + 1)
+    : reference_manager((SSTRING_TRACE_BEGIN(), len(str) + 1)), _str(_data), 
+      _length(_block->size - 1)
 {
+    SSTRING_STATS(record_deep_copy());
     copy(str);
+    SSTRING_TRACE_END(construct);
 }
 
 SString::SString(pointer begin, pointer end)
-    : reference_manager(end - begin)
+    : reference_manager((SSTRING_TRACE_BEGIN(), end - begin + 1)), _str(_data),
+      _length(end - begin)
 {
+    SSTRING_STATS(record_deep_copy());
+
     for(unsigned i = 0; begin != end; ++begin)
     {
         _data[i++] = *begin;
     }
 
-    _data[*_size] = '\0';
+    _data[_length] = '\0';
+    SSTRING_TRACE_END(construct);
 }
 
 SString::SString(unsigned n, char fill)
-    : reference_manager(n + 1)
+    : reference_manager((SSTRING_TRACE_BEGIN(), n + 1)), _str(_data), _length(n)
 {
-    for (unsigned i = 0; i < n; ++i)
-    {
-        _data[i] = fill;
-    }
-
-    _data[*_size - 1] = '\0';
+    std::memset(_data, fill, n);
+    _data[_length] = '\0';
+    SSTRING_TRACE_END(construct);
 }
 
 SString::SString(const_pointer buffer, size_type n) 
-    : reference_manager(n + 1)
+    : reference_manager((SSTRING_TRACE_BEGIN(), n + 1)), _str(_data), _length(n)
 {
     validate_pointer(buffer);
+    SSTRING_STATS(record_deep_copy());
 
-    for(unsigned i = 0; i < n; ++i)
-    {
-        _data[i] = buffer[i];
-    }
+    std::memcpy(_data, buffer, n);
+    _data[_length] = '\0';
+    SSTRING_TRACE_END(construct);
+}
+
+SString::SString(const std::string& str)
+    : SString(str.data(), str.size()) {}
+
+#if __cplusplus >= 201703L
+// A default constructed view has no data
+SString::SString(std::string_view str)
+    : SString(str.data() ? str.data() : empty_string, str.size()) {}
+#endif
 
-    _data[*_size - 1] = '\0';
+SString::SString(std::unique_ptr<char[]> buffer, size_type n)
+    : reference_manager(buffer.get(), new control_block()), _str(_data), 
+      _length(n)
+{
+    buffer.release();
+    _block->size = n + 1;
+    _block->ref_count = 1;
+    _data[n] = '\0';
+
+    // Counted as an allocation, the adopted buffer is released like any other
+    SSTRING_STATS(record_allocation(n + 1, n + 1 + sizeof(control_block)));
 }
 
 SString::SString(const self_type& origin)
-    : reference_manager(origin) {}
+    : reference_manager(origin), _str(origin._str), _length(origin._length) {}
 
-// Inherited virtual destructor handles deallocation
-SString::~SString() {}
+SString::SString(self_type&& origin) noexcept
+    : reference_manager(empty_string, &empty_block), _str(_data), _length(0)
+{
+    swap(*this, origin);
+}
 
-SString::size_type SString::len(const_pointer str)
+SString::SString(const reference_manager<char>& buffer, const_pointer begin,
+                 size_type n)
+    : reference_manager(buffer), _str(begin), _length(n)
 {
-    if (catch_null_exception(str))
+    if (begin[n] != '\0')
     {
-        return 0;
+        *this = SString(begin, n);
     }
+}
 
-    size_type length;
+SString::SString(const_pointer str, size_type n, control_block* block)
+    : reference_manager(const_cast<pointer>(str), block), _str(str), 
+      _length(n) {}
 
-    // Counts the number of characters before null terminator
-    for(length = 0; str[length] != '\0'; ++length);
+SString SString::from_static(const_pointer str, control_block* block)
+{
+    return SString(str, block->size - 1, block);
+}
 
-    return length;
+SString::SString(uninitialized_tag, size_type n)
+    : reference_manager(n + 1), _str(_data), _length(n)
+{
+    _data[n] = '\0';
+}
+
+// Inherited virtual destructor handles deallocation
+SString::~SString() {}
+
+SString::size_type SString::len(const_pointer str)
+{
+    return str == NULL ? 0 : std::strlen(str);
 }
 
 void SString::copy(const_pointer source)
@@ -104,7 +162,12 @@ void SString::copy(const_pointer source)
 
 SString::size_type SString::length() const
 {
-    return *_size - 1;
+    return _length;
+}
+
+SString::size_type SString::size() const
+{
+    return _length + 1;
 }
 
 bool SString::empty() const
@@ -114,38 +177,83 @@ bool SString::empty() const
 
 bool SString::compare_equal(const self_type& str) const
 {
+    SSTRING_TRACE(compare);
+
     // Strings are different sizes, they are not the same
     if (length() != str.length())
     {
         return false;
     }
     // Strings are both empty, or they share the same data
-    if ((length() == 0 && str.length() == 0) || _data == str._data)
+    if ((length() == 0 && str.length() == 0) || _str == str._str)
     {
         return true;
     }
 
-    // Iterate through each string and compare characters
-    return *this == str._data;
+    // Compare characters, the lengths are already known to match
+    return std::memcmp(_str, str._str, length()) == 0;
+}
+
+std::size_t SString::hash() const
+{
+    // The cached hash is only valid for strings that span the whole buffer, 
+    // slices share the control block with the string they were cut from
+    bool whole = _str == _data && _length + 1 == _block->size;
+    if (whole && _block->hash != 0)
+    {
+        return _block->hash;
+    }
+
+    std::size_t result = hash(_str, _length);
+
+    // Immortal blocks may live in read-only storage and are never written
+    if (whole && !is_immortal())
+    {
+        _block->hash = result;
+    }
+    return result;
+}
+
+std::size_t SString::hash(const_pointer str, size_type n)
+{
+    unsigned long long h = fnv_offset_basis;
+    for (size_type i = 0; i < n; ++i)
+    {
+        h = (h ^ (unsigned char)str[i]) * fnv_prime;
+    }
+
+    return static_cast<std::size_t>(h) ? static_cast<std::size_t>(h) : 1;
 }
 
 /****** OPERATIONS ******/
 
 SString SString::substring(unsigned begin, unsigned end) const
 {
-    if (begin > end || begin > length() || end > length())
+    SSTRING_TRACE(substring);
+
+    SSTRING_CHECK(begin <= end && end <= length(), throw invalid_substring());
+
+    // The inclusive end is clamped to the string's own characters, since a
+    // slice may continue into its parent's
+    return SString((pointer)_str + begin,
+                   (pointer)_str + std::min<size_type>(end + 1, _length));
+}
+
+sstring_result<SString> SString::try_substring(unsigned begin, unsigned end) const
+{
+    if (begin > end || end > length())
     {
-        throw invalid_substring();
+        return sstring_result<SString>();
     }
 
-    return SString(_data + begin, _data + end + 1);
+    return substring(begin, end);
 }
 
 SString SString::truncate(unsigned width) const
 {
     if (width > length())
     {
-        return *this + SString(width - length() + 1, ' ');
+        return pad(0, width - length() + 1, ' ');
     }
     
     return substring(0, width - 1);
@@ -157,7 +265,7 @@ bool SString::is_upper() const
 {
     for(unsigned i = 0; i < length(); ++i)
     {
-        if(std::isalpha(_data[i]) && std::islower(_data[i])) 
+        if(std::isalpha(_str[i]) && std::islower(_str[i])) 
         {
             return false;
         }
@@ -165,29 +273,352 @@ bool SString::is_upper() const
     return true;
 }
 
-SString& SString::strip(char strip_c){
+SString SString::strip(const char_set& chars) const &
+{
+    SSTRING_TRACE(strip);
+
+    SString result(*this);
+    result.trim(chars, true, true);
+    return result;
+}
+
+SString SString::strip(const char_set& chars) &&
+{
+    SSTRING_TRACE(strip);
+
+    trim(chars, true, true);
+    return std::move(*this);
+}
+
+SString SString::strip(char strip_c) const &
+{
     // null terminator cannot be used as strip seed
     if(strip_c == '\0')
         throw std::invalid_argument("null terminator cannot be used as strip seed!");
-	
-	// double pointer
-    const_pointer it_begin = begin();
-    const_pointer it_end = end();
-    
-    while(*it_begin == strip_c)
-        it_begin++;
-    while(*it_end == strip_c || *it_end == '\0')
-        it_end--;
-    
-    if (it_end < it_begin)
-        *this = SString();
-    else{
-        SString result((pointer)it_begin, (pointer)it_end + 1);
-        *this = result;
+
+    return strip(char_set(strip_c));
+}
+
+SString SString::strip(char strip_c) &&
+{
+    if(strip_c == '\0')
+        throw std::invalid_argument("null terminator cannot be used as strip seed!");
+
+    return std::move(*this).strip(char_set(strip_c));
+}
+
+SString SString::lstrip(const char_set& chars) const &
+{
+    SSTRING_TRACE(strip);
+
+    SString result(*this);
+    result.trim(chars, true, false);
+    return result;
+}
+
+SString SString::lstrip(const char_set& chars) &&
+{
+    SSTRING_TRACE(strip);
+
+    trim(chars, true, false);
+    return std::move(*this);
+}
+
+SString SString::rstrip(const char_set& chars) const &
+{
+    SSTRING_TRACE(strip);
+
+    SString result(*this);
+    result.trim(chars, false, true);
+    return result;
+}
+
+SString SString::rstrip(const char_set& chars) &&
+{
+    SSTRING_TRACE(strip);
+
+    trim(chars, false, true);
+    return std::move(*this);
+}
+
+SString SString::ljust(size_type width, char fill) const
+{
+    return width > _length ? pad(0, width - _length, fill) : *this;
+}
+
+SString SString::rjust(size_type width, char fill) const
+{
+    return width > _length ? pad(width - _length, 0, fill) : *this;
+}
+
+SString SString::center(size_type width, char fill) const
+{
+    if (width <= _length)
+    {
+        return *this;
     }
 
-    return *this;
+    // The odd character of padding goes on the left when width is odd, as 
+    // python places it
+    size_type margin = width - _length;
+    size_type left = margin / 2 + (margin & width & 1);
+    return pad(left, margin - left, fill);
+}
+
+SString SString::zfill(size_type width) const
+{
+    if (width <= _length)
+    {
+        return *this;
+    }
+
+    SString result = pad(width - _length, 0, '0');
+    if (_length && (_str[0] == '+' || _str[0] == '-'))
+    {
+        result._data[0] = _str[0];
+        result._data[width - _length] = '0';
+    }
+
+    return result;
+}
+
+// Writes str with its tabs expanded to out, or only measures it when out is
+// NULL. Returns the expanded length. Runs of characters between tabs are
+// copied whole, only scanned for the line breaks that reset the column
+static SString::size_type expand_tabs(SString::const_pointer str,
+                                      SString::size_type n,
+                                      SString::size_type tabsize,
+                                      SString::pointer out)
+{
+    SString::const_pointer end = str + n;
+    SString::size_type length = 0;
+    SString::size_type column = 0;
+
+    for (SString::const_pointer run = str; run < end; )
+    {
+        SString::const_pointer tab =
+            (SString::const_pointer)std::memchr(run, '\t', end - run);
+        SString::const_pointer next = tab ? tab : end;
+
+        for (SString::const_pointer c = run; c < next; ++c)
+        {
+            column = *c == '\n' || *c == '\r' ? 0 : column + 1;
+        }
+        if (out)
+        {
+            std::memcpy(out + length, run, next - run);
+        }
+        length += next - run;
+
+        if (tab)
+        {
+            SString::size_type spaces = tabsize ? tabsize - column % tabsize : 0;
+            if (out)
+            {
+                std::memset(out + length, ' ', spaces);
+            }
+            length += spaces;
+            column += spaces;
+        }
+        run = tab ? tab + 1 : end;
+    }
+
+    return length;
+}
+
+SString SString::expandtabs(size_type tabsize) const
+{
+    if (std::memchr(_str, '\t', _length) == NULL)
+    {
+        return *this;
+    }
+
+    SString result(uninitialized_tag(), expand_tabs(_str, _length, tabsize, NULL));
+    expand_tabs(_str, _length, tabsize, result._data);
+    return result;
+}
+
+SString::size_type SString::find(const self_type& sub, size_type pos) const
+{
+    return find(sub._str, sub._length, pos);
+}
+
+SString::size_type SString::find(const_pointer sub, size_type pos) const
+{
+    return find(sub, len(sub), pos);
+}
+
+SString::size_type SString::rfind(const self_type& sub, size_type pos) const
+{
+    return rfind(sub._str, sub._length, pos);
+}
+
+SString::size_type SString::rfind(const_pointer sub, size_type pos) const
+{
+    return rfind(sub, len(sub), pos);
+}
+
+#if __cplusplus >= 201703L
+SString::size_type SString::find(std::string_view sub, size_type pos) const
+{
+    return find(sub.data(), sub.size(), pos);
+}
+
+SString::size_type SString::rfind(std::string_view sub, size_type pos) const
+{
+    return rfind(sub.data(), sub.size(), pos);
+}
+#endif
+
+std::tuple<SString, SString, SString> 
+SString::partition(const self_type& sep) const
+{
+    size_type index = find(sep._str, sep._length, 0);
+    if (index == npos)
+    {
+        return std::make_tuple(*this, SString(*this, end(), 0), 
+                               SString(*this, end(), 0));
+    }
+
+    return partition_at(index, sep._length);
+}
+
+std::tuple<SString, SString, SString> 
+SString::partition(const_pointer sep) const
+{
+    size_type n = len(sep);
+    size_type index = find(sep, n, 0);
+    if (index == npos)
+    {
+        return std::make_tuple(*this, SString(*this, end(), 0), 
+                               SString(*this, end(), 0));
+    }
+
+    return partition_at(index, n);
+}
+
+std::tuple<SString, SString, SString> 
+SString::rpartition(const self_type& sep) const
+{
+    size_type index = rfind(sep._str, sep._length, npos);
+    if (index == npos)
+    {
+        return std::make_tuple(SString(), SString(), *this);
+    }
+
+    return partition_at(index, sep._length);
+}
+
+std::tuple<SString, SString, SString> 
+SString::rpartition(const_pointer sep) const
+{
+    size_type n = len(sep);
+    size_type index = rfind(sep, n, npos);
+    if (index == npos)
+    {
+        return std::make_tuple(SString(), SString(), *this);
+    }
+
+    return partition_at(index, n);
+}
+
+#if __cplusplus >= 201703L
+std::tuple<SString, SString, SString> 
+SString::partition(std::string_view sep) const
+{
+    size_type index = find(sep.data(), sep.size(), 0);
+    if (index == npos)
+    {
+        return std::make_tuple(*this, SString(*this, end(), 0), 
+                               SString(*this, end(), 0));
+    }
+
+    return partition_at(index, sep.size());
+}
+
+std::tuple<SString, SString, SString> 
+SString::rpartition(std::string_view sep) const
+{
+    size_type index = rfind(sep.data(), sep.size(), npos);
+    if (index == npos)
+    {
+        return std::make_tuple(SString(), SString(), *this);
+    }
+
+    return partition_at(index, sep.size());
+}
+#endif
+
+bool SString::startswith(const self_type& prefix) const
+{
+    return length() >= prefix.length() && 
+           std::memcmp(_str, prefix._str, prefix.length()) == 0;
+}
+
+bool SString::startswith(std::initializer_list<const_pointer> prefixes) const
+{
+    for (const_pointer prefix : prefixes)
+    {
+        size_type n = len(prefix);
+        if (length() >= n && std::memcmp(_str, prefix, n) == 0)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool SString::startswith(const SStringMatcher& prefixes) const
+{
+    return prefixes.match_prefix(*this);
+}
+
+bool SString::endswith(const self_type& suffix) const
+{
+    return length() >= suffix.length() && 
+           std::memcmp(end() - suffix.length(), suffix._str, suffix.length()) == 0;
+}
+
+bool SString::endswith(std::initializer_list<const_pointer> suffixes) const
+{
+    for (const_pointer suffix : suffixes)
+    {
+        size_type n = len(suffix);
+        if (length() >= n && std::memcmp(end() - n, suffix, n) == 0)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
 
+bool SString::endswith(const SStringMatcher& suffixes) const
+{
+    return suffixes.match_suffix(*this);
+}
+
+SString::size_type 
+SString::find_any(std::initializer_list<const_pointer> patterns) const
+{
+    return find_any(SStringMatcher(patterns));
+}
+
+SString::size_type SString::find_any(const SStringMatcher& patterns) const
+{
+    return patterns.find(*this).position;
+}
+
+bool SString::fnmatch(const_pointer pattern) const
+{
+    // Compiling a glob only pays off over many strings
+    return SStringGlob::match_once(pattern, *this);
+}
+
+bool SString::fnmatch(const SStringGlob& patterns) const
+{
+    return patterns.match(*this);
 }
 
 bool SString::isnumeric(void) const {
@@ -198,9 +629,9 @@ bool SString::is_bin_num(void) const {
 
     /* checking for the prefix 0b and if passed, checking for
      * characters to be either '0' or '1' */
-    if ((size() > 2) && (_data[0] == '0') && (_data[1] == 'b')) {
+    if ((size() > 2) && (_str[0] == '0') && (_str[1] == 'b')) {
         for (unsigned int i = 2; i < size() - 1; ++i) {
-            if ((_data[i] != '0') && (_data[i] != '1'))
+            if ((_str[i] != '0') && (_str[i] != '1'))
                 return false;
         }
         return true;
@@ -213,9 +644,9 @@ bool SString::is_oct_num(void) const {
 
     /* checking for the prefix 0o and if passed, checking for
      * character to be in between '0' and '7' for octal based numbers */
-    if ((size() > 2) && (_data[0] == '0') && (_data[1] == 'o')) {
+    if ((size() > 2) && (_str[0] == '0') && (_str[1] == 'o')) {
         for (unsigned int i = 2; i < size() - 1; ++i) {
-            if (!(std::isdigit(_data[i]) && (_data[i] >= 48)  && (_data[i] <= 55)))
+            if (!(std::isdigit(_str[i]) && (_str[i] >= 48)  && (_str[i] <= 55)))
                 return false;
         }
         return true;
@@ -229,7 +660,7 @@ bool SString::is_dec_num(void) const {
     /* Checking the characters to be digits in case of decimal number,
      */
     for (unsigned int i = 0; i < size() - 1; ++i) {
-        if (!(std::isdigit(_data[i]))) {
+        if (!(std::isdigit(_str[i]))) {
             return false;
         }
     }
@@ -242,10 +673,10 @@ bool SString::is_hex_num(void) const {
     /* checking for prefic 0x and if passed, checking the hexadecimal digits
      * '0' to '9', 'A', 'B', 'C', 'D', 'E', 'F' both uppercase and lower case
      * based on ASCII values */
-    if ((size() > 2) && (_data[0] == '0') && (_data[1] == 'x')) {
+    if ((size() > 2) && (_str[0] == '0') && (_str[1] == 'x')) {
         for (unsigned int i = 2; i < size() - 1; ++i) {
-            if (!((std::isdigit(_data[i])) || (_data[i] >= 65  && _data[i] <= 70)
-                    || (_data[i] >= 97 && _data[i] <= 102)))
+            if (!((std::isdigit(_str[i])) || (_str[i] >= 65  && _str[i] <= 70)
+                    || (_str[i] >= 97 && _str[i] <= 102)))
                 return false;
         }
         return true;
@@ -258,39 +689,277 @@ bool SString::is_hex_num(void) const {
 
 SString::const_iterator SString::begin() const
 {
-    return _data;
+    return _str;
 }
 
 SString::const_iterator SString::end() const
 {
-    return &_data[length()];
+    return _str + length();
+}
+
+/****** TYPE CASTS ******/
+
+SString::const_pointer SString::c_str() const
+{
+    return _str;
 }
 
 /****** SUBROUTINES ******/
 
-void SString::validate_pointer(const_pointer str)
+SString::size_type 
+SString::find(const_pointer sub, size_type n, size_type pos) const
+{
+    if (n == 0 || pos > _length || n > _length - pos)
+    {
+        // An empty string is found at pos, as long as pos is in the string
+        return n == 0 && pos <= _length ? pos : npos;
+    }
+
+    const_pointer first = _str + pos;
+    const_pointer last = _str + _length - n; // The last possible start
+
+#ifdef __SSE2__
+    // Each block tests 16 starts by comparing the first and last characters
+    // of sub, only starts matching both are compared in full
+    if (n > 1)
+    {
+        const __m128i head = _mm_set1_epi8(sub[0]);
+        const __m128i tail = _mm_set1_epi8(sub[n - 1]);
+
+        for (; last - first >= 15; first += 16)
+        {
+            __m128i starts = _mm_loadu_si128((const __m128i*)first);
+            __m128i ends = _mm_loadu_si128((const __m128i*)(first + n - 1));
+            unsigned mask = _mm_movemask_epi8(
+                _mm_and_si128(_mm_cmpeq_epi8(starts, head), 
+                              _mm_cmpeq_epi8(ends, tail)));
+
+            for (; mask; mask &= mask - 1)
+            {
+                const_pointer candidate = first + __builtin_ctz(mask);
+                if (std::memcmp(candidate + 1, sub + 1, n - 2) == 0)
+                {
+                    return candidate - _str;
+                }
+            }
+        }
+    }
+#endif
+
+    if (n == 1)
+    {
+        first = (const_pointer)std::memchr(first, sub[0], last - first + 1);
+        return first ? first - _str : npos;
+    }
+
+    // memchr skips to each candidate start
+    while (first <= last)
+    {
+        first = (const_pointer)std::memchr(first, sub[0], last - first + 1);
+        if (first == NULL)
+        {
+            return npos;
+        }
+        if (std::memcmp(first + 1, sub + 1, n - 1) == 0)
+        {
+            return first - _str;
+        }
+        ++first;
+    }
+
+    return npos;
+}
+
+SString::size_type 
+SString::rfind(const_pointer sub, size_type n, size_type pos) const
 {
-    if (str) 
+    if (n > _length)
+    {
+        return npos;
+    }
+
+    // One past the last possible start, starts are tested from the end
+    size_type end = std::min(pos, _length - n) + 1;
+
+    if (n == 0)
+    {
+        return end - 1;
+    }
+
+#ifdef __SSE2__
+    if (n > 1)
+    {
+        const __m128i head = _mm_set1_epi8(sub[0]);
+        const __m128i tail = _mm_set1_epi8(sub[n - 1]);
+
+        for (; end >= 16; end -= 16)
+        {
+            const_pointer block = _str + end - 16;
+            __m128i starts = _mm_loadu_si128((const __m128i*)block);
+            __m128i ends = _mm_loadu_si128((const __m128i*)(block + n - 1));
+            unsigned mask = _mm_movemask_epi8(
+                _mm_and_si128(_mm_cmpeq_epi8(starts, head), 
+                              _mm_cmpeq_epi8(ends, tail)));
+
+            while (mask)
+            {
+                unsigned bit = 31 - __builtin_clz(mask);
+                if (std::memcmp(block + bit + 1, sub + 1, n - 2) == 0)
+                {
+                    return block + bit - _str;
+                }
+                mask &= ~(1u << bit);
+            }
+        }
+    }
+#endif
+
+    for (; end > 0; --end)
+    {
+        const_pointer start = _str + end - 1;
+        if (*start == sub[0] && std::memcmp(start + 1, sub + 1, n - 1) == 0)
+        {
+            return start - _str;
+        }
+    }
+
+    return npos;
+}
+
+std::tuple<SString, SString, SString> 
+SString::partition_at(size_type index, size_type n) const
+{
+    // An empty separator is always found, so it is only refused here
+    if (n == 0)
+    {
+        throw std::invalid_argument("empty separator");
+    }
+
+    return std::make_tuple(SString(*this, _str, index),
+                           SString(*this, _str + index, n),
+                           SString(*this, _str + index + n, 
+                                   _length - index - n));
+}
+
+void SString::trim(const char_set& chars, bool left, bool right)
+{
+    const_pointer first = _str;
+    const_pointer last = _str + _length;
+
+    while (left && first != last && chars.contains(*first))
+    {
+        ++first;
+    }
+    while (right && last != first && chars.contains(*(last - 1)))
+    {
+        --last;
+    }
+
+    _str = first;
+    _length = last - first;
+    terminate();
+}
+
+void SString::terminate()
+{
+    if (_str[_length] == '\0')
     {
         return;
     }
 
-    throw std::invalid_argument("char pointer points to null");
+    // External buffers, such as an archive's read-only mapping, and immortal
+    // ones are never written
+    if (_block->ref_count == 1 && _block->size != external)
+    {
+        _data[_str - _data + _length] = '\0';
+    }
+    else
+    {
+        *this = SString(_str, _length);
+    }
 }
 
-bool SString::catch_null_exception(const_pointer str)
+SString SString::pad(size_type left, size_type right, char fill) const
 {
-    try
+    SString result(uninitialized_tag(), left + _length + right);
+    std::memset(result._data, fill, left);
+    std::memcpy(result._data + left, _str, _length);
+    std::memset(result._data + left + _length, fill, right);
+    return result;
+}
+
+/****** CHARACTER SETS ******/
+
+SString::char_set::char_set(const_pointer chars) : char_set()
+{
+    for (; chars && *chars; ++chars)
     {
-        validate_pointer(str);
-        return false;
+        insert(*chars);
     }
-    catch(const std::invalid_argument& err)
+}
+
+SString::char_set::char_set(const SString& chars) : char_set()
+{
+    for (char c : chars)
     {
-        return true;
+        insert(c);
     }
 }
 
+SString::char_set::char_set(char c) : char_set()
+{
+    insert(c);
+}
+
+void SString::char_set::insert(char c)
+{
+    unsigned char b = c;
+    _bits[b >> 6] |= 1ull << (b & 63);
+}
+
+SString::size_type SString::piece_length(const self_type& str)
+{
+    return str.length();
+}
+
+SString::size_type SString::piece_length(const_pointer str)
+{
+    return len(str);
+}
+
+SString::const_pointer SString::piece_data(const self_type& str)
+{
+    return str._str;
+}
+
+SString::const_pointer SString::piece_data(const_pointer str)
+{
+    // null pointers join as empty strings, the same as SString(nullptr)
+    return str ? str : "";
+}
+
+#if __cplusplus >= 201703L
+SString::size_type SString::piece_length(std::string_view str)
+{
+    return str.size();
+}
+
+SString::const_pointer SString::piece_data(std::string_view str)
+{
+    return str.data();
+}
+#endif
+
+void SString::validate_pointer(const_pointer str)
+{
+    SSTRING_CHECK(str != NULL, throw std::invalid_argument("char pointer points to null"));
+}
+
+void SString::throw_bad_index(int index)
+{
+    throw bad_index(index);
+}
+
 /****** COPY AND SWAP ******/
 SString::self_type& SString::operator=(const SString& str)
 {
@@ -304,6 +973,14 @@ SString::self_type& SString::operator=(const SString& str)
     return *this;
 }
 
+SString::self_type& SString::operator=(SString&& str) noexcept
+{
+    // The moved string is left empty and the old data released right away
+    SString moved(std::move(str));
+    swap(*this, moved);
+    return *this;
+}
+
 // TODO Review if there is a faster way to perform reassignment with a c-string
 SString::self_type& SString::operator=(const_pointer str)
 {
@@ -319,8 +996,9 @@ void SString::swap(SString& new_string, SString& old_string)
     using std::swap;
 
     swap(new_string._data, old_string._data);
-    swap(new_string._size, old_string._size);
-    swap(new_string._ref_count, old_string._ref_count);
+    swap(new_string._block, old_string._block);
+    swap(new_string._str, old_string._str);
+    swap(new_string._length, old_string._length);
     return;
 }
 
@@ -329,13 +1007,14 @@ void SString::swap(SString& new_string, SString& old_string)
 // TODO Review and establish a faster way to perform string concatenation
 SString operator+(const SString& lhs, const char* rhs)
 {
+    SSTRING_TRACE(concatenate);
+
     // TODO create an append function that this operator will call
-    char* buffer = new char[lhs.length() + std::strlen(rhs)];
-    std::strcpy(buffer, lhs._data);
-    std::strcat(buffer, rhs);
+    SString::size_type rhs_length = SString::len(rhs);
 
-    SString result(buffer);
-    delete [] buffer;
+    SString result(SString::uninitialized_tag(), lhs.length() + rhs_length);
+    std::memcpy(result._data, lhs._str, lhs.length());
+    std::memcpy(result._data + lhs.length(), rhs, rhs_length);
     return result;
 }
 
@@ -346,18 +1025,121 @@ SString operator+(const char* lhs, const SString& rhs)
 
 SString operator+(const SString& lhs, const SString& rhs)
 {
-    return lhs + rhs._data;
+    SSTRING_TRACE(concatenate);
+
+    SString result(SString::uninitialized_tag(), lhs.length() + rhs.length());
+    std::memcpy(result._data, lhs._str, lhs.length());
+    std::memcpy(result._data + lhs.length(), rhs._str, rhs.length());
+    return result;
+}
+
+#if __cplusplus >= 201703L
+SString operator+(const SString& lhs, std::string_view rhs)
+{
+    SSTRING_TRACE(concatenate);
+
+    SString result(SString::uninitialized_tag(), lhs.length() + rhs.size());
+    std::memcpy(result._data, lhs._str, lhs.length());
+    std::memcpy(result._data + lhs.length(), rhs.data(), rhs.size());
+    return result;
+}
+
+SString operator+(std::string_view lhs, const SString& rhs)
+{
+    SSTRING_TRACE(concatenate);
+
+    SString result(SString::uninitialized_tag(), lhs.size() + rhs.length());
+    std::memcpy(result._data, lhs.data(), lhs.size());
+    std::memcpy(result._data + lhs.size(), rhs._str, rhs.length());
+    return result;
+}
+#endif
+
+SString SString::repeat(size_type n) const
+{
+    if (n == 1)
+    {
+        return *this;
+    }
+    if (n == 0 || _length == 0)
+    {
+        return SString();
+    }
+
+    SSTRING_TRACE(concatenate);
+
+    if (n > max_length() / _length)
+    {
+        throw std::length_error("repeated string is too long");
+    }
+
+    size_type total = _length * n;
+    SString result(uninitialized_tag(), total);
+    std::memcpy(result._data, _str, _length);
+
+    for (size_type filled = _length; filled < total; )
+    {
+        size_type chunk = std::min(filled, total - filled);
+        std::memcpy(result._data + filled, result._data, chunk);
+        filled += chunk;
+    }
+
+    return result;
+}
+
+SString operator*(const SString& str, SString::size_type n)
+{
+    return str.repeat(n);
+}
+
+SString operator*(SString::size_type n, const SString& str)
+{
+    return str.repeat(n);
 }
 
 /****** STREAM OPERATORS ******/
 std::ostream& operator << (std::ostream& os, const SString& str)
 {
-    os << str._data;
+    SSTRING_TRACE(stream_io);
+
+    // Slices may not be null terminated, so exactly length() characters are
+    // written, padded to the stream's width like a c-string. The characters
+    // go straight to the stream buffer under one sentry, as the standard
+    // inserters do, rather than through os.write() and os.put()
+    std::ostream::sentry guard(os);
+    if (!guard)
+    {
+        return os;
+    }
+
+    std::streamsize n = str.length();
+    std::streamsize padding = os.width() > n ? os.width() - n : 0;
+    bool left = (os.flags() & std::ios::adjustfield) == std::ios::left;
+    std::streambuf* buffer = os.rdbuf();
+
+    bool written = true;
+    for (std::streamsize i = 0; written && !left && i < padding; ++i)
+    {
+        written = buffer->sputc(os.fill()) != std::char_traits<char>::eof();
+    }
+    written = written && buffer->sputn(str._str, n) == n;
+    for (std::streamsize i = 0; written && left && i < padding; ++i)
+    {
+        written = buffer->sputc(os.fill()) != std::char_traits<char>::eof();
+    }
+
+    if (!written)
+    {
+        os.setstate(std::ios::badbit);
+    }
+    os.width(0);
     return os;
 }
 
 std::istream& operator >> (std::istream& is, SString& str)
 {
+    SSTRING_TRACE(stream_io);
+
     char* buffer = new char[100];
 
     is.get(buffer, 100);
@@ -371,32 +1153,20 @@ std::istream& operator >> (std::istream& is, SString& str)
     return is;
 }
 
-/****** ACCESS OEPRATORS ******/
-
-char SString::operator [] (int index) const
-{
-    int len = length();
-    if (index >= len || index < len * -1)
-    {
-        throw bad_index(index);
-    }
-    if(index < 0) 
-    {
-        index += len;
-    }
-
-    return *(_data + index);
-}
-
 /****** COMPARISON OPERATORS ******/
 bool operator==(const SString& lhs, const char* rhs)
 {
-    if(SString::catch_null_exception(rhs))
+    if(rhs == NULL)
     {
         return false;
     }
 
-    return std::strcmp(lhs._data, rhs) == 0;
+    SSTRING_TRACE(compare);
+
+    // lhs may be a slice that isn't null terminated or hold embedded nulls,
+    // so rhs is measured no further than one past lhs's length
+    std::size_t n = strnlen(rhs, lhs.length() + 1);
+    return n == lhs.length() && std::memcmp(lhs._str, rhs, n) == 0;
 }
 bool operator==(const char* lhs, const SString& rhs)
 {
@@ -416,11 +1186,17 @@ bool operator!=(const char* lhs, const SString& rhs)
 }
 bool operator!=(const SString& lhs, const SString& rhs)
 {
-    return !(lhs == rhs._data);
+    return !(lhs == rhs);
 }
 bool operator< (const SString& lhs, const char* rhs)
 {
-    return std::strcmp(lhs._data, rhs) < 0;
+    SSTRING_TRACE(compare);
+
+    std::size_t n = strnlen(rhs, lhs.length() + 1);
+    int result = std::memcmp(lhs._str, rhs, std::min<std::size_t>(n, lhs.length()));
+
+    // When lhs is a prefix of rhs, lhs is less only if rhs is longer
+    return result < 0 || (result == 0 && lhs.length() < n);
 }
 bool operator< (const char* lhs, const SString& rhs)
 {
@@ -428,7 +1204,12 @@ bool operator< (const char* lhs, const SString& rhs)
 }
 bool operator< (const SString& lhs, const SString& rhs)
 {
-    return lhs < rhs._data;
+    SSTRING_TRACE(compare);
+
+    SString::size_type n = std::min(lhs.length(), rhs.length());
+    int result = std::memcmp(lhs._str, rhs._str, n);
+
+    return result < 0 || (result == 0 && lhs.length() < rhs.length());
 }
 bool operator> (const SString& lhs, const char* rhs)
 {
@@ -440,6 +1221,61 @@ bool operator> (const char* lhs, const SString& rhs)
 }
 bool operator> (const SString& lhs, const SString& rhs)
 {
-    return !(lhs < rhs._data);
+    return !(lhs < rhs);
 }
 
+#if __cplusplus >= 201703L
+bool operator==(const SString& lhs, std::string_view rhs)
+{
+    SSTRING_TRACE(compare);
+
+    return lhs.length() == rhs.size() &&
+           (rhs.empty() || std::memcmp(lhs._str, rhs.data(), rhs.size()) == 0);
+}
+bool operator==(std::string_view lhs, const SString& rhs)
+{
+    return rhs == lhs;
+}
+bool operator!=(const SString& lhs, std::string_view rhs)
+{
+    return !(lhs == rhs);
+}
+bool operator!=(std::string_view lhs, const SString& rhs)
+{
+    return !(rhs == lhs);
+}
+bool operator< (const SString& lhs, std::string_view rhs)
+{
+    SSTRING_TRACE(compare);
+
+    return std::string_view(lhs) < rhs;
+}
+bool operator< (std::string_view lhs, const SString& rhs)
+{
+    SSTRING_TRACE(compare);
+
+    return lhs < std::string_view(rhs);
+}
+bool operator> (const SString& lhs, std::string_view rhs)
+{
+    return !(lhs < rhs);
+}
+bool operator> (std::string_view lhs, const SString& rhs)
+{
+    return !(lhs < rhs);
+}
+#endif
+
+
+/****** STATIC LITERALS ******/
+
+SString operator"" _ss(const char* str, size_t n)
+{
+    // Every _ss literal shares one immortal block. Its size belongs to no
+    // literal, so the block never holds a literal's hash, and isn't the
+    // external size either
+    static SString::control_block block = { SString::immortal,
+                                            SString::immortal, 0 };
+
+    return SString(str, n, &block);
+}
@@ -5,6 +5,8 @@
 #define RC_MANAGER_H
 
 #include <cstddef> // NULL
+#include "sstring_stats.h"
+#include "sstring_trace.h"
 
 template <typename T> 
 class reference_manager
@@ -19,12 +21,40 @@ class reference_manager
     typedef reference_manager   self_type;
     typedef unsigned            size_type;
 
-    // Allocates a T array of a defined size
-    reference_manager(size_type size = 0);
+    // Reference count of data that is never counted or released, such as 
+    // literals in static storage
+    static const size_type immortal = static_cast<size_type>(-1);
+
+    // Bookkeeping shared by every reference to the data, allocated once 
+    // alongside the data
+    struct control_block
+    {
+        size_type size; // The number of elements in the data
+        size_type ref_count; // The number of references to the data
+        std::size_t hash; // Cached hash of the data, 0 until computed
+    };
+
+    // Size of a block whose data the reference manager didn't allocate, such
+    // as a mapped file. The block begins an external_block, and its release
+    // function frees the data and the block once the last reference is gone
+    static const size_type external = 0;
+
+    struct external_block : control_block
+    {
+        void (*release)(external_block* block);
+    };
+
+    // Allocates a T array of a defined size, which must be positive
+    reference_manager(size_type size);
 
     // Points this object to the origin data, increments reference count
     reference_manager(const self_type& origin);
 
+    // Points this object to data and its block. An immortal block's data is
+    // never counted or released, otherwise this object takes over one of the
+    // block's references
+    reference_manager(pointer data, control_block* block);
+
     // Decrements the reference count, if the reference count is zero, releases
     // the data
     virtual ~reference_manager();
@@ -35,15 +65,17 @@ class reference_manager
     // Returns the number of references to the array
     size_type ref_count() const;
 
+    // Tests if the data is immortal and never counted or released
+    bool is_immortal() const;
+
   protected:
 
-    size_type* _size; // The shared size of the allocated data
-    size_type* _ref_count; // The number of references to the data
+    control_block* _block; // The shared size, reference count and hash
     pointer   _data; // The shared data object
 
   private:
 
-    // Releases the data. This will delete the data, ref count and size for ALL
+    // Releases the data. This will delete the data and control block for ALL
     // referenced objects
     void release();
 
@@ -56,23 +88,43 @@ Implementation Section for the reference_manager.
 #ifndef RC_MANAGER_CPP
 #define RC_MANAGER_CPP
 
+template <typename T>
+const typename reference_manager<T>::size_type reference_manager<T>::immortal;
+
+template <typename T>
+const typename reference_manager<T>::size_type reference_manager<T>::external;
+
 template <typename T>
 reference_manager<T>::reference_manager(size_type size)
-    : _size(new size_type(size)), 
-      _ref_count(new unsigned(1)), 
-      _data(new value_type[size]) {}
+    : _block(new control_block()), 
+      _data(new value_type[size]) 
+{
+    _block->size = size;
+    _block->ref_count = 1;
+
+    SSTRING_STATS(record_allocation(size, 
+                                    size * sizeof(T) + sizeof(control_block)));
+}
 
 template <typename T>
 reference_manager<T>::reference_manager(const self_type& origin)
-    : _size(origin._size), _ref_count(origin._ref_count), _data(origin._data)
+    : _block(origin._block), _data(origin._data)
 {
-    ++(*_ref_count);
+    if (_block->ref_count != immortal)
+    {
+        ++_block->ref_count;
+        SSTRING_STATS(record_shared_copy(_block->ref_count));
+    }
 }
 
+template <typename T>
+reference_manager<T>::reference_manager(pointer data, control_block* block)
+    : _block(block), _data(data) {}
+
 template <typename T>
 reference_manager<T>::~reference_manager()
 {
-    if(--(*_ref_count) == 0)
+    if(_block->ref_count != immortal && --_block->ref_count == 0)
     {
         release();
     }
@@ -81,24 +133,38 @@ reference_manager<T>::~reference_manager()
 template <typename T>
 unsigned reference_manager<T>::size() const
 {
-    return *_size;
+    return _block->size;
 }
 
 template <typename T>
 unsigned reference_manager<T>::ref_count() const
 {
-    return *_ref_count;
+    return _block->ref_count;
+}
+
+template <typename T>
+bool reference_manager<T>::is_immortal() const
+{
+    return _block->ref_count == immortal;
 }
 
 template <typename T>
 void reference_manager<T>::release()
 {
-    delete [] _data;
-    delete _size;
-    delete _ref_count;
+    if (_block->size == external)
+    {
+        external_block* block = static_cast<external_block*>(_block);
+        block->release(block);
+    }
+    else
+    {
+        SSTRING_STATS(record_free(_block->size * sizeof(T) + sizeof(control_block)));
 
-    _size = NULL;
-    _ref_count = NULL;
+        delete [] _data;
+        delete _block;
+    }
+
+    _block = NULL;
     _data = NULL;
 }
 
@@ -113,9 +179,28 @@ void reference_manager<T>::release()
 #ifndef STRING_H
 #define STRING_H
 
+#include <cstddef>
+#include <cstdint>
 #include <cstring>
+#include <functional>
 #include <iostream>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
 #include <stdexcept> 
+#include <string>
+#include <tuple>
+#include <utility>
+#if __cplusplus >= 201703L
+#include <string_view>
+#endif
+#include "sstring_check.h"
+
+class SStringMatcher;
+class SStringGlob;
+class SStringLineReader;
+class SStringWriter;
+template <typename Entry> class sstring_table;
 
 // SString inherits the functionality of the reference manager to allow for 
 // smart allocation, copy, and deallocation
@@ -129,10 +214,103 @@ class SString : public reference_manager<char>
     typedef const char* const_pointer;
     typedef size_t      size_type;
     typedef const char* const_iterator;
+    typedef std::ptrdiff_t difference_type;
+
+    // Returned by searches that find nothing
+    static const size_type npos = static_cast<size_type>(-1);
+
+    // A set of bytes stored as a 256-bit bitmap, so testing a character is
+    // one shift and mask
+    class char_set
+    {
+      public:
+
+        // The empty set
+        constexpr char_set() : _bits{ 0, 0, 0, 0 } {}
+
+        // The characters of a c-string or SString, NULL is the empty set
+        char_set(const_pointer chars);
+        char_set(const SString& chars);
+
+        // A single character
+        char_set(char c);
+
+        // Python's string.whitespace: space, \t, \n, \v, \f and \r
+        static constexpr char_set whitespace()
+        {
+            return char_set(0x100003e00ull, 0, 0, 0);
+        }
+
+        // Tests if c is in the set
+        bool contains(char c) const
+        {
+            unsigned char b = c;
+            return (_bits[b >> 6] >> (b & 63)) & 1;
+        }
+
+        // Adds c to the set
+        void insert(char c);
+
+      private:
+
+        constexpr char_set(unsigned long long a, unsigned long long b,
+                           unsigned long long c, unsigned long long d)
+            : _bits{ a, b, c, d } {}
+
+        unsigned long long _bits[4];
+    };
+
+    // Bound of slice() standing for one left out of a python slice, so that
+    // s[::-1] is s.slice(omitted, omitted, -1)
+    static const difference_type omitted = PTRDIFF_MIN;
+
+    // A strided view of an SString's characters, see slice()
+    class stride_view;
+
+    // Maps every byte to a replacement and holds a set of bytes to remove,
+    // like the tables built by python's str.maketrans. See translate()
+    class translation
+    {
+      public:
+
+        // The identity mapping, removing nothing
+        translation();
+
+        // Maps from to to
+        void set(char from, char to);
+
+        // Removes c, removal takes precedence over any mapping of c
+        void remove(char c);
+
+        // Returns the replacement of c
+        char operator[](char c) const { return _map[(unsigned char)c]; }
+
+        // Tests if c is removed
+        bool removes(char c) const
+        {
+            unsigned char b = c;
+            return (_removed[(b & 15) | (b >> 7 << 4)] >> ((b >> 4) & 7)) & 1;
+        }
+
+      private:
+
+        friend class SString;
+
+        unsigned char _map[256]; // Replacement of every byte
+
+        // Bit h of _removed[lo] is set when the byte with high nibble h and 
+        // low nibble lo is removed, the last 16 entries hold nibbles 8 to 15.
+        // Laid out for lookups by nibble shuffles
+        unsigned char _removed[32];
+
+        unsigned _rows; // Bit h is set if any byte with high nibble h is mapped
+        bool _removing; // Tests if any byte is removed
+    };
 
     /****** CONSTRUCTORS ******/
 
-    // Default construction
+    // Default construction views a shared, immortal empty string, so it never
+    // allocates
     SString();
 
     // c-string constructor
@@ -147,9 +325,33 @@ class SString : public reference_manager<char>
     // Buffer construction
     SString(const_pointer buffer, size_type n);
 
+    // Copies the characters of a std::string without counting them
+    explicit SString(const std::string& str);
+
+#if __cplusplus >= 201703L
+    // Copies the characters of a view without counting them, so the view
+    // needn't be null terminated
+    SString(std::string_view str);
+#endif
+
+    // Adopting constructor, takes over buffer without copying it. The buffer
+    // must be allocated with new char[] and hold at least n + 1 characters,
+    // a terminator is written after the first n
+    SString(std::unique_ptr<char[]> buffer, size_type n);
+
     // Copy Constructor increments reference count
     SString(const self_type& origin);
 
+    // Move constructor takes over origin's reference, leaving origin empty
+    SString(self_type&& origin) noexcept;
+
+    // Slice constructor, views n characters at begin inside buffer. The slice
+    // shares the buffer's reference count and copies nothing when a null
+    // terminator follows the characters, otherwise they are copied into a
+    // buffer of its own so every string stays terminated
+    SString(const reference_manager<char>& buffer, const_pointer begin, 
+            size_type n);
+
     ~SString();
 
     /****** CAPACITY ******/
@@ -157,26 +359,292 @@ class SString : public reference_manager<char>
     // Returns the number of characters in the string
     size_type length() const;
 
+    // Returns the number of characters including the null terminator
+    size_type size() const;
+
     // Tests if the string is empty;
     bool empty() const;
 
     // len counts the number of characters in a cstring before null character
     static size_type len(const_pointer str);
 
+    /****** HASHING ******/
+
+    // Returns the FNV-1a hash of the string. The hash of a string that owns 
+    // its whole buffer is cached in the shared control block
+    std::size_t hash() const;
+
+    // Returns the FNV-1a hash of n characters at str, never 0
+    static std::size_t hash(const_pointer str, size_type n);
+
+    // Compile time counterpart of hash(), used to precompute literal hashes
+    static constexpr std::size_t static_hash(const_pointer str, size_type n,
+        unsigned long long h = fnv_offset_basis)
+    {
+        return n == 0 ? (static_cast<std::size_t>(h) ? static_cast<std::size_t>(h) : 1)
+                      : static_hash(str + 1, n - 1, 
+                                    (h ^ (unsigned char)*str) * fnv_prime);
+    }
+
+    // Returns the CRC-32C (Castagnoli) checksum of the string, using the
+    // SSE4.2 crc32 instruction where the CPU has it. Unlike hash() it isn't
+    // cached, the control block has no room for it
+    std::uint32_t crc32c() const;
+
+    // Extends the checksum crc with n characters at data. Starting from 0,
+    // updating with each piece gives the crc32c() of their concatenation
+    static std::uint32_t crc32c_update(std::uint32_t crc, const_pointer data,
+                                       size_type n);
+    static std::uint32_t crc32c_update(std::uint32_t crc, const self_type& str);
+
+    /****** STATIC LITERALS ******/
+
+    // Returns a string viewing str in static storage through an immortal 
+    // block, see SSTRING_LITERAL. Nothing is allocated or copied
+    static self_type from_static(const_pointer str, control_block* block);
+
     /****** OPERATIONS ******/
     
     // Returns a copy of the string from [begin:end]
     self_type substring(unsigned begin=0, unsigned end=0) const;
 
-    // Returns a substring of the string from (0, width)
+    // substring(), or nothing when the bounds don't exist. Never throws
+    sstring_result<self_type> try_substring(unsigned begin=0, unsigned end=0) const;
+
+    // Returns the characters from start up to stop, taking every step-th,
+    // like python's s[start:stop:step]. Negative bounds count from the end
+    // and out of range bounds are clamped the way python clamps them. The
+    // view shares the string's buffer and copies nothing until materialized,
+    // when a step of 1 to the end becomes a slice of the buffer and a step
+    // of -1 is reversed 16 characters at a time. An omitted step is 1. Throws
+    // std::invalid_argument if step is 0
+    stride_view slice(difference_type start, difference_type stop = omitted,
+                      difference_type step = 1) const;
+
+    // Returns a substring of the string from (0, width). A shorter string is
+    // padded with spaces to width + 1 characters
     self_type truncate(unsigned width = 8) const;
 
     /****** PYTHONIC METHODS ******/
 
     bool is_upper() const;
 
-    //  Strip the SString in begining and end
-    self_type& strip(char strip_c = '\n');
+    // Returns the string without the leading and trailing characters in 
+    // chars, like python's str.strip(chars). The result is this string itself
+    // when nothing is stripped, or a slice sharing its buffer when only
+    // leading characters are. Otherwise the result needs a terminator of its
+    // own: a temporary that is the only reference to its buffer is trimmed
+    // and terminated in place, anything else copies the stripped characters
+    self_type strip(const char_set& chars = char_set::whitespace()) const &;
+    self_type strip(const char_set& chars = char_set::whitespace()) &&;
+
+    // Strips a single character, which can't be the null terminator
+    self_type strip(char strip_c) const &;
+    self_type strip(char strip_c) &&;
+
+    // Strip only the leading or only the trailing characters in chars
+    self_type lstrip(const char_set& chars = char_set::whitespace()) const &;
+    self_type lstrip(const char_set& chars = char_set::whitespace()) &&;
+    self_type rstrip(const char_set& chars = char_set::whitespace()) const &;
+    self_type rstrip(const char_set& chars = char_set::whitespace()) &&;
+
+    // Returns the string padded with fill to width characters, on the right,
+    // on the left or on both sides, like python's str.ljust(width, fill),
+    // str.rjust and str.center. The result is written into one buffer of its
+    // final size. Returns this string itself when it is at least width long
+    self_type ljust(size_type width, char fill = ' ') const;
+    self_type rjust(size_type width, char fill = ' ') const;
+    self_type center(size_type width, char fill = ' ') const;
+
+    // Returns the string padded on the left with zeros to width characters,
+    // after a leading '+' or '-', like python's str.zfill(width)
+    self_type zfill(size_type width) const;
+
+    // Returns the string with every tab replaced by spaces up to the next
+    // multiple of tabsize columns, counted from the last newline or carriage
+    // return, like python's str.expandtabs(tabsize). Returns this string
+    // itself when it has no tabs
+    self_type expandtabs(size_type tabsize = 8) const;
+
+    // Returns a translation mapping each character of from to the character
+    // at the same position in to and removing the characters of remove, like
+    // python's str.maketrans(from, to, remove). Throws std::invalid_argument
+    // if from and to differ in length
+    static translation maketrans(const_pointer from, const_pointer to,
+                                 const_pointer remove = NULL);
+
+    // Returns a copy with every character replaced through table and the
+    // characters it removes left out, like python's str.translate(table). 
+    // The result is allocated once, sized by counting the removed characters
+    // first. Returns this string itself if the table changes nothing
+    self_type translate(const translation& table) const;
+
+    // Returns each character as two lowercase hex digits, like python's
+    // bytes.hex()
+    self_type hex() const;
+
+    // Decodes hex digits of either case into bytes, like python's
+    // bytes.fromhex(text) except that whitespace isn't skipped. Returns false
+    // and leaves bytes unchanged if text has an odd length or a character
+    // that isn't a hex digit
+    static bool fromhex(const self_type& text, self_type& bytes);
+
+    // Returns the characters encoded as padded base64, like python's
+    // base64.b64encode(s). The url safe alphabet has '-' and '_' in place of
+    // '+' and '/'
+    self_type b64encode() const;
+    self_type urlsafe_b64encode() const;
+
+    // Decodes padded base64 into bytes, like python's
+    // base64.b64decode(s, validate=True). Returns false and leaves bytes
+    // unchanged if text's length isn't a multiple of 4, or it has characters
+    // outside the alphabet or padding anywhere but the end
+    static bool b64decode(const self_type& text, self_type& bytes);
+    static bool urlsafe_b64decode(const self_type& text, self_type& bytes);
+
+    // How the unicode transcoders handle malformed input, like python's
+    // errors='strict' and errors='replace'. Replace substitutes U+FFFD for
+    // each unpaired surrogate or maximal invalid UTF-8 sequence. Scoped so
+    // the names stay free for python methods such as replace
+    enum class unicode_errors
+    {
+        strict,
+        replace
+    };
+
+    // Tests if the string is well formed UTF-8, without overlong forms,
+    // surrogates or code points past U+10FFFF
+    bool validate_utf8() const;
+
+    // Returns the Latin-1 bytes decoded into UTF-8, like python's
+    // bytes.decode('latin-1'). Every byte is a code point, so never fails
+    static self_type from_latin1(const self_type& bytes);
+
+    // Decodes n UTF-16 code units in native byte order into UTF-8, like
+    // python's bytes.decode('utf-16'). Returns false and leaves str unchanged
+    // if a surrogate is unpaired and errors is strict
+    static bool decode_utf16(const char16_t* units, size_type n, self_type& str,
+                             unicode_errors errors = unicode_errors::strict);
+
+    // Encodes the string's UTF-8 as UTF-16 code units in native byte order,
+    // like python's str.encode('utf-16') without the byte order mark.
+    // Returns false and leaves units unchanged if the string isn't valid
+    // UTF-8 and errors is strict
+    bool encode_utf16(std::u16string& units, 
+                      unicode_errors errors = unicode_errors::strict) const;
+
+    // Concatenates the elements of range with this string between each
+    // element, like python's sep.join(iterable). Elements may be SStrings,
+    // c-strings or (C++17) string views
+    template <typename Range>
+    self_type join(const Range& range) const;
+
+    // Joins the elements in [first, last). Forward iterators are walked twice
+    // so the result is allocated exactly once, input iterators are gathered
+    // into a growing buffer the result adopts. Throws std::length_error if
+    // the result is too long to allocate
+    template <typename InputIterator>
+    self_type join(InputIterator first, InputIterator last) const;
+
+    // Tests if the string begins with prefix
+    bool startswith(const self_type& prefix) const;
+
+    // Tests if the string begins with any of the prefixes, like python's 
+    // str.startswith(tuple). A compiled matcher checks every prefix in one 
+    // walk of the string's beginning
+    bool startswith(std::initializer_list<const_pointer> prefixes) const;
+    bool startswith(const SStringMatcher& prefixes) const;
+
+    // Tests if the string ends with suffix, or with any of the suffixes
+    bool endswith(const self_type& suffix) const;
+    bool endswith(std::initializer_list<const_pointer> suffixes) const;
+    bool endswith(const SStringMatcher& suffixes) const;
+
+    // Tests if the strings are equal once ASCII letters are lowercased, as
+    // python's str.lower() of both would be, without lowercasing a copy of
+    // either. Bytes outside ASCII compare exactly. 16 characters are folded
+    // and compared at a time
+    bool equals_ci(const self_type& other) const;
+    bool equals_ci(const_pointer other) const;
+
+    // Returns a negative, zero or positive int as the string orders before,
+    // equal to or after other once ASCII letters are lowercased
+    int compare_ci(const self_type& other) const;
+
+    // Tests if the string begins with prefix ignoring ASCII case
+    bool startswith_ci(const self_type& prefix) const;
+    bool startswith_ci(const_pointer prefix) const;
+
+    // Returns the hash of the string with ASCII letters lowercased, so
+    // strings that are equals_ci hash alike. Unlike hash() it isn't cached
+    std::size_t hash_ci() const;
+
+    // Key a std::unordered_map<SString, V, ci_hash, ci_equal> or a
+    // std::set<SString, ci_less> ignoring ASCII case
+    struct ci_hash
+    {
+        std::size_t operator()(const SString& str) const { return str.hash_ci(); }
+    };
+
+    struct ci_equal
+    {
+        bool operator()(const SString& lhs, const SString& rhs) const
+        {
+            return lhs.equals_ci(rhs);
+        }
+    };
+
+    struct ci_less
+    {
+        bool operator()(const SString& lhs, const SString& rhs) const
+        {
+            return lhs.compare_ci(rhs) < 0;
+        }
+    };
+
+    // Returns the index of the first occurrence of sub starting at or after
+    // pos, or npos. Candidates are found by comparing the first and last
+    // characters of sub against 16 positions at once
+    size_type find(const self_type& sub, size_type pos = 0) const;
+    size_type find(const_pointer sub, size_type pos = 0) const;
+
+    // Returns the index of the last occurrence of sub starting at or before
+    // pos, or npos
+    size_type rfind(const self_type& sub, size_type pos = npos) const;
+    size_type rfind(const_pointer sub, size_type pos = npos) const;
+#if __cplusplus >= 201703L
+    size_type find(std::string_view sub, size_type pos = 0) const;
+    size_type rfind(std::string_view sub, size_type pos = npos) const;
+#endif
+
+    // Splits the string at the first occurrence of sep into the part before
+    // it, sep and the part after it, like python's str.partition(sep). When
+    // sep is missing the string is followed by two empty strings. The part
+    // after sep is a slice of this string's buffer, while the part before it
+    // and sep are copied, since every string is null terminated. Throws
+    // std::invalid_argument if sep is empty
+    std::tuple<self_type, self_type, self_type> partition(const self_type& sep) const;
+    std::tuple<self_type, self_type, self_type> partition(const_pointer sep) const;
+
+    // Splits the string at the last occurrence of sep. When sep is missing
+    // two empty strings are followed by the string
+    std::tuple<self_type, self_type, self_type> rpartition(const self_type& sep) const;
+    std::tuple<self_type, self_type, self_type> rpartition(const_pointer sep) const;
+#if __cplusplus >= 201703L
+    std::tuple<self_type, self_type, self_type> partition(std::string_view sep) const;
+    std::tuple<self_type, self_type, self_type> rpartition(std::string_view sep) const;
+#endif
+
+    // Returns the index of the leftmost occurrence of any of the patterns, or
+    // npos. Prefer a compiled matcher when searching many strings
+    size_type find_any(std::initializer_list<const_pointer> patterns) const;
+    size_type find_any(const SStringMatcher& patterns) const;
+
+    // Tests if the whole string matches a shell-style wildcard pattern, like
+    // python's fnmatch.fnmatchcase. Compile an SStringGlob when matching many
+    // strings, or against several patterns at once
+    bool fnmatch(const_pointer pattern) const;
+    bool fnmatch(const SStringGlob& patterns) const;
 
     // Returns true if the string is an integer
     // or a binary number with prefix 0b,
@@ -184,6 +652,29 @@ class SString : public reference_manager<char>
     // or a octal number with prefic 0o
     bool isnumeric(void) const;
 
+    /****** SIMILARITY ******/
+
+    // Returns the fewest single character insertions, deletions and
+    // substitutions turning this string into other. Computed with Myers'
+    // bit-parallel algorithm, a column of 64 cells of the edit table per word
+    size_type levenshtein(const self_type& other) const;
+
+    // Returns the edit distance if it is at most max, otherwise max + 1.
+    // Strings differing in length by more than max aren't compared, and the
+    // table is abandoned as soon as its last row can't come back under max
+    size_type levenshtein(const self_type& other, size_type max) const;
+
+    // Returns the number of positions where the strings differ, counted 16
+    // characters at a time. Throws std::invalid_argument if their lengths
+    // differ
+    size_type hamming(const self_type& other) const;
+
+    // Returns twice the number of matching characters over the total length
+    // of both strings, like python's
+    // difflib.SequenceMatcher(None, str, other).ratio(), including its
+    // heuristic ignoring popular characters of other
+    double similarity_ratio(const self_type& other) const;
+
     /****** ITERATORS ******/
 
     // returns a random-access iterator to the beginning of the string
@@ -195,6 +686,7 @@ class SString : public reference_manager<char>
     /****** COPY AND SWAP ******/
 
     self_type& operator=(const self_type& str);
+    self_type& operator=(self_type&& str) noexcept;
     self_type& operator=(const_pointer str);
 
     // Swaps ownership of resources
@@ -205,6 +697,18 @@ class SString : public reference_manager<char>
     friend self_type operator+(const self_type& lhs, const_pointer rhs);
     friend self_type operator+(const_pointer lhs, const self_type& rhs);
     friend self_type operator+(const self_type& lhs, const self_type& rhs);
+#if __cplusplus >= 201703L
+    friend self_type operator+(const self_type& lhs, std::string_view rhs);
+    friend self_type operator+(std::string_view lhs, const self_type& rhs);
+#endif
+
+    // Returns the string repeated n times, like python's s * n. The result is
+    // allocated once and filled by copying the first copy, then doubling the
+    // filled part with each memcpy. Repeating once returns the string itself.
+    // Throws std::length_error if the result is too long to allocate
+    self_type repeat(size_type n) const;
+    friend self_type operator*(const self_type& str, size_type n);
+    friend self_type operator*(size_type n, const self_type& str);
 
     /****** STREAM OPERATORS ******/
 
@@ -213,7 +717,27 @@ class SString : public reference_manager<char>
 
     /****** ACCESS OPERATORS ******/
 
-    char operator [] (int index) const;
+    // Returns the character at index, negative indices count back from the
+    // end like python's. A bad index throws bad_index when checked, see
+    // sstring_check.h
+    char operator [] (int index) const
+    {
+        int n = static_cast<int>(_length);
+        SSTRING_CHECK(index < n && index >= -n, throw_bad_index(index));
+        return _str[index < 0 ? index + n : index];
+    }
+
+    // Returns the character at index, or nothing for a bad index. Never
+    // throws
+    sstring_result<char> try_at(int index) const
+    {
+        int n = static_cast<int>(_length);
+        if (index >= n || index < -n)
+        {
+            return sstring_result<char>();
+        }
+        return _str[index < 0 ? index + n : index];
+    }
 
     /****** COMPARISON OPERATORS ******/
 
@@ -239,24 +763,129 @@ class SString : public reference_manager<char>
     friend bool operator> (const_pointer lhs, const self_type& rhs);
     friend bool operator> (const self_type& lhs, const self_type& rhs);
 
+#if __cplusplus >= 201703L
+    // Views, such as std::strings, compare without being copied or counted,
+    // with the same results as the SString operators
+    friend bool operator==(const self_type& lhs, std::string_view rhs);
+    friend bool operator==(std::string_view lhs, const self_type& rhs);
+    friend bool operator!=(const self_type& lhs, std::string_view rhs);
+    friend bool operator!=(std::string_view lhs, const self_type& rhs);
+    friend bool operator< (const self_type& lhs, std::string_view rhs);
+    friend bool operator< (std::string_view lhs, const self_type& rhs);
+    friend bool operator> (const self_type& lhs, std::string_view rhs);
+    friend bool operator> (std::string_view lhs, const self_type& rhs);
+#endif
+
     /****** TYPE CASTS ******/
-    operator const char*() const { return _data; }
-    operator const unsigned long*() const { return (const unsigned long*)_data; }
+
+    // Returns the characters followed by a null terminator. Every string,
+    // slices included, is terminated, so nothing is copied or written
+    const_pointer c_str() const;
+
+    operator const char*() const { return c_str(); }
+    operator const unsigned long*() const { return (const unsigned long*)c_str(); }
+
+#if __cplusplus >= 201703L
+    // Views the characters without copying them
+    operator std::string_view() const noexcept
+    {
+        return std::string_view(_str, _length);
+    }
+#endif
 
   private:
 
+    // SStringArray builds its shared buffer through the private constructors
+    friend class SStringArray;
+    friend class SStringMatcher;
+    friend class SStringGlob;
+    friend class SStringLineReader;
+    friend class SStringWriter;
+    template <typename Entry> friend class sstring_table;
+
+    friend self_type operator"" _ss(const_pointer str, size_t n);
+
+    static const unsigned long long fnv_offset_basis = 14695981039346656037ull;
+    static const unsigned long long fnv_prime = 1099511628211ull;
+
+    const_pointer _str; // The first character of this string within _data
+    size_type _length; // The number of characters viewed from _str
+
     /****** SUBROUTINES ******/
 
-    // Throws an exception if the pointer is NULL
+    // Throws an exception if the pointer is NULL, when checked
     static void validate_pointer(const_pointer);
-    
-    // Returns true if a null exception was thrown
-    static bool catch_null_exception(const_pointer);
+
+    // Throws bad_index, kept out of line so accessors inline without it
+    [[noreturn]] static void throw_bad_index(int index);
     
     // copies each character from source including null character. Stops 
     // copying if the buffer is full
     void copy(const_pointer source);
 
+    // Tag for the constructor that leaves the characters uninitialized
+    struct uninitialized_tag {};
+
+    // Allocates n uninitialized characters followed by a null terminator, to
+    // be written through _data by the caller
+    SString(uninitialized_tag, size_type n);
+
+    // find() and rfind() of n characters at sub
+    size_type find(const_pointer sub, size_type n, size_type pos) const;
+    size_type rfind(const_pointer sub, size_type n, size_type pos) const;
+
+    // levenshtein() and similarity_ratio() of m characters at a and n at b.
+    // They touch no reference count, so SStringArray scores a column from
+    // many threads through them
+    static size_type levenshtein(const_pointer a, size_type m, const_pointer b,
+                                 size_type n, size_type max);
+    static double similarity_ratio(const_pointer a, size_type m,
+                                   const_pointer b, size_type n);
+
+    // partition() and rpartition() at the occurrence of n characters at sep
+    std::tuple<self_type, self_type, self_type> 
+    partition_at(size_type index, size_type n) const;
+
+    // Returns the string between left and right copies of fill, written into
+    // one buffer of the final size
+    self_type pad(size_type left, size_type right, char fill) const;
+
+    // Moves the string's bounds past the characters in chars at either end,
+    // then terminates it
+    void trim(const char_set& chars, bool left, bool right);
+
+    // Makes sure a null terminator follows the string. It is written in place
+    // when this is the only reference to a buffer the reference manager
+    // allocated, otherwise the characters are copied into a buffer of their
+    // own
+    void terminate();
+
+    // Views n characters of static storage through an immortal block
+    SString(const_pointer str, size_type n, control_block* block);
+
+    // The longest string a buffer holds. Buffers are sized by the reference
+    // manager's size_type, with room for the terminator
+    static constexpr size_type max_length()
+    {
+        return static_cast<reference_manager<char>::size_type>(-1) - 1;
+    }
+
+    // Length and data accessors for the element types accepted by join()
+    static size_type piece_length(const self_type& str);
+    static size_type piece_length(const_pointer str);
+    static const_pointer piece_data(const self_type& str);
+    static const_pointer piece_data(const_pointer str);
+#if __cplusplus >= 201703L
+    static size_type piece_length(std::string_view str);
+    static const_pointer piece_data(std::string_view str);
+#endif
+
+    // join() implementations selected by iterator category
+    template <typename Iterator>
+    self_type join(Iterator first, Iterator last, std::input_iterator_tag) const;
+    template <typename Iterator>
+    self_type join(Iterator first, Iterator last, std::forward_iterator_tag) const;
+
     // helper functions for the isnumeric() function
     bool is_hex_num(void) const;
     bool is_bin_num(void) const;
@@ -264,6 +893,123 @@ class SString : public reference_manager<char>
     bool is_oct_num(void) const;
 };
 
+class SString::stride_view
+{
+  public:
+
+    typedef SString::size_type       size_type;
+    typedef SString::difference_type difference_type;
+
+    // Walks the characters of the view in order
+    class const_iterator
+    {
+      public:
+
+        typedef std::forward_iterator_tag iterator_category;
+        typedef char                      value_type;
+        typedef SString::difference_type  difference_type;
+        typedef const char*               pointer;
+        typedef const char&               reference;
+
+        const_iterator(const char* first, difference_type step, size_type index)
+            : _first(first), _step(step), _index(index) {}
+
+        reference operator*() const
+        {
+            return _first[static_cast<difference_type>(_index) * _step];
+        }
+
+        const_iterator& operator++() { ++_index; return *this; }
+        const_iterator operator++(int)
+        {
+            const_iterator it(*this);
+            ++_index;
+            return it;
+        }
+
+        bool operator==(const const_iterator& rhs) const
+        {
+            return _index == rhs._index;
+        }
+        bool operator!=(const const_iterator& rhs) const
+        {
+            return _index != rhs._index;
+        }
+
+      private:
+
+        const char* _first;
+        difference_type _step;
+        size_type _index;
+    };
+
+    // Returns the number of characters in the view
+    size_type length() const { return _length; }
+    size_type size() const { return _length; }
+    bool empty() const { return _length == 0; }
+
+    // Returns the distance between consecutive characters in the string
+    difference_type step() const { return _step; }
+
+    // Returns the i-th character of the view, i < length()
+    char operator[](size_type i) const
+    {
+        return _first[static_cast<difference_type>(i) * _step];
+    }
+
+    const_iterator begin() const { return const_iterator(_first, _step, 0); }
+    const_iterator end() const { return const_iterator(_first, _step, _length); }
+
+    // Materializes the view as an SString
+    SString str() const;
+    operator SString() const { return str(); }
+
+  private:
+
+    friend class SString;
+
+    stride_view(const SString& string, const char* first, difference_type step,
+                size_type length)
+        : _string(string), _first(first), _step(step), _length(length) {}
+
+    SString _string; // Keeps the viewed buffer alive
+    const char* _first; // The first character of the view
+    difference_type _step;
+    size_type _length;
+};
+
+/****** STATIC LITERALS ******/
+
+// Returns a string viewing the literal in place. The literal's length comes
+// from the compiler and its reference count is immortal, so constructing,
+// copying and destroying the string never allocates. Unlike SSTRING_LITERAL
+// it has no precomputed hash, every hash() of it is computed again, so prefer
+// SSTRING_LITERAL for keys that are looked up often
+SString operator"" _ss(const char* str, size_t n);
+
+// Expands to an SString viewing a string literal through its own immortal 
+// block in static storage. The block, including the literal's length and 
+// hash, is constant initialized at compile time
+#define SSTRING_LITERAL(str)                                                  \
+    ([]() -> SString {                                                        \
+        static SString::control_block block = {                               \
+            sizeof(str), SString::immortal,                                   \
+            SString::static_hash(str, sizeof(str) - 1) };                     \
+        return SString::from_static(str, &block);                             \
+    }())
+
+namespace std
+{
+    template <>
+    struct hash<SString>
+    {
+        size_t operator()(const SString& str) const
+        {
+            return str.hash();
+        }
+    };
+}
+
 struct invalid_substring : public std::exception
 {
     const char * _error;
@@ -297,5 +1043,115 @@ struct bad_index : public std::exception
         return _index;
     }
 };
+/*******
+Implementation Section for the SString templates.
+*******/
+
+template <typename Range>
+SString SString::join(const Range& range) const
+{
+    using std::begin;
+    using std::end;
+
+    return join(begin(range), end(range));
+}
+
+template <typename InputIterator>
+SString SString::join(InputIterator first, InputIterator last) const
+{
+    typedef typename std::iterator_traits<InputIterator>::iterator_category
+        category;
+
+    return join(first, last, category());
+}
+
+template <typename Iterator>
+SString SString::join(Iterator first, Iterator last, 
+                      std::forward_iterator_tag) const
+{
+    if (first == last)
+    {
+        return SString();
+    }
+
+    // First pass sums the length of every element and separator
+    size_type total = 0;
+    for (Iterator it = first; it != last; ++it)
+    {
+        size_type piece = piece_length(*it);
+        size_type n = piece + (it == first ? 0 : length());
+        if (n < piece || n > max_length() - total)
+        {
+            throw std::length_error("joined string is too long");
+        }
+        total += n;
+    }
+
+    // Second pass copies each element into the exactly sized buffer
+    SString result(uninitialized_tag(), total);
+    pointer out = result._data;
+    for (Iterator it = first; it != last; ++it)
+    {
+        if (it != first)
+        {
+            std::memcpy(out, _str, length());
+            out += length();
+        }
+
+        size_type n = piece_length(*it);
+        std::memcpy(out, piece_data(*it), n);
+        out += n;
+    }
+
+    return result;
+}
+
+template <typename Iterator>
+SString SString::join(Iterator first, Iterator last, 
+                      std::input_iterator_tag) const
+{
+    // Single pass iterators can't be measured up front, so the elements are
+    // gathered into a buffer that doubles as it fills, which the result then
+    // adopts. The buffer always has room for the terminator
+    size_type capacity = 64;
+    size_type total = 0;
+    std::unique_ptr<char[]> buffer(new char[capacity]);
+
+    for (bool first_piece = true; first != last; ++first, first_piece = false)
+    {
+        size_type piece = piece_length(*first);
+        size_type n = piece + (first_piece ? 0 : length());
+        if (n < piece || n > max_length() - total)
+        {
+            throw std::length_error("joined string is too long");
+        }
+
+        size_type needed = total + n + 1;
+        if (needed > capacity)
+        {
+            while (capacity < needed)
+            {
+                capacity = capacity <= (max_length() + 1) / 2 ? capacity * 2 
+                                                              : needed;
+            }
+
+            std::unique_ptr<char[]> grown(new char[capacity]);
+            std::memcpy(grown.get(), buffer.get(), total);
+            buffer.swap(grown);
+        }
+
+        if (!first_piece)
+        {
+            std::memcpy(buffer.get() + total, _str, length());
+            total += length();
+        }
+
+        std::memcpy(buffer.get() + total, piece_data(*first), piece);
+        total += piece;
+    }
+
+    return SString(std::move(buffer), total);
+}
+
 #endif // STRING_H
 
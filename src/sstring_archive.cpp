@@ -0,0 +1,382 @@
+/*
+File: sstring_archive.cpp
+
+Copyright (c) 2018 Alexander DuPree
+
+This software is released as open source through the MIT License
+
+Authors: Alexander DuPree
+
+https://github.com/AlexanderJDupree/Python-Strings-for-CPP
+
+*/
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <system_error>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "sstring_archive.h"
+
+// An archive is laid out as:
+//
+//   header
+//   for each string: 64-bit length, characters, terminator, padding to 8
+//   offset table: the file offset of each string's length
+//
+// In map archives the table alternates keys and values, sorted by key. The
+// checksum covers everything after the header.
+
+typedef std::uint64_t record_length;
+
+static const char archive_magic[8] = { 'S', 'S', 'T', 'R', 'A', 'R', 'C', '\0' };
+static const std::uint32_t archive_version = 3;
+static const std::uint32_t archive_byte_order = 0x01020304;
+static const std::uint32_t map_flag = 1;
+
+struct archive_header
+{
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t byte_order; // archive_byte_order as the writer stored it
+    std::uint32_t reserved; // Written as zero
+    std::uint32_t flags;
+    std::uint64_t size; // The number of strings in the offset table
+    std::uint64_t table; // Offset of the offset table
+    std::uint64_t checksum;
+};
+
+// The control block of an archive's mapping, shared by every string loaded
+// from it so the file stays mapped while any of them is alive
+struct mapping_block : reference_manager<char>::external_block
+{
+    void* map;
+    std::size_t bytes;
+};
+
+static void unmap(reference_manager<char>::external_block* block)
+{
+    mapping_block* mapping = static_cast<mapping_block*>(block);
+    munmap(mapping->map, mapping->bytes);
+    delete mapping;
+}
+
+// Returns n rounded up to a multiple of 8
+static std::size_t align(std::size_t n)
+{
+    return (n + 7) & ~static_cast<std::size_t>(7);
+}
+
+// Returns a checksum of n bytes at data, the CRC-32C of the bytes, so opening
+// an archive validates it at the speed of the crc32 instruction
+static std::uint64_t checksum(const char* data, std::size_t n)
+{
+    return SString::crc32c_update(0, data, n);
+}
+
+// Orders strings byte by byte, with a prefix before any longer string
+static int compare(const SString& lhs, const SString& rhs)
+{
+    std::size_t n = std::min(lhs.length(), rhs.length());
+    int order = n ? std::memcmp(lhs.begin(), rhs.begin(), n) : 0;
+    if (order != 0)
+    {
+        return order;
+    }
+
+    return lhs.length() < rhs.length() ? -1 : lhs.length() > rhs.length();
+}
+
+static void throw_errno(const char* call)
+{
+    throw std::system_error(errno, std::generic_category(), call);
+}
+
+/****** SAVING ******/
+
+void SStringArchive::write(const char* path, std::vector<SString>& strings, bool map)
+{
+    if (map)
+    {
+        std::size_t pairs = strings.size() / 2;
+        std::vector<std::size_t> order(pairs);
+        for (std::size_t i = 0; i < pairs; ++i)
+        {
+            order[i] = i;
+        }
+        std::sort(order.begin(), order.end(), [&strings](std::size_t a, std::size_t b) {
+            return compare(strings[a * 2], strings[b * 2]) < 0;
+        });
+
+        std::vector<SString> sorted;
+        sorted.reserve(strings.size());
+        for (std::size_t i = 0; i < pairs; ++i)
+        {
+            if (i > 0 && compare(strings[order[i] * 2], sorted[sorted.size() - 2]) == 0)
+            {
+                throw std::invalid_argument("archived maps can't repeat a key");
+            }
+            sorted.push_back(strings[order[i] * 2]);
+            sorted.push_back(strings[order[i] * 2 + 1]);
+        }
+        strings.swap(sorted);
+    }
+
+    std::size_t table = sizeof(archive_header);
+    for (const SString& str : strings)
+    {
+        table += align(sizeof(record_length) + str.length() + 1);
+    }
+
+    // The whole file is assembled in memory so it is checksummed and written
+    // in one pass
+    std::vector<char> file(table + strings.size() * sizeof(std::uint64_t));
+    std::vector<std::uint64_t> offsets;
+    offsets.reserve(strings.size());
+
+    std::size_t offset = sizeof(archive_header);
+    for (const SString& str : strings)
+    {
+        record_length length = str.length();
+        std::memcpy(&file[offset], &length, sizeof(length));
+        if (length)
+        {
+            std::memcpy(&file[offset + sizeof(length)], str.begin(), length);
+        }
+
+        offsets.push_back(offset);
+        offset += align(sizeof(length) + length + 1);
+    }
+    if (!offsets.empty())
+    {
+        std::memcpy(&file[table], offsets.data(), offsets.size() * sizeof(std::uint64_t));
+    }
+
+    archive_header header = archive_header();
+    std::memcpy(header.magic, archive_magic, sizeof(archive_magic));
+    header.version = archive_version;
+    header.byte_order = archive_byte_order;
+    header.flags = map ? map_flag : 0;
+    header.size = strings.size();
+    header.table = table;
+    header.checksum = checksum(&file[sizeof(header)], file.size() - sizeof(header));
+    std::memcpy(&file[0], &header, sizeof(header));
+
+    std::FILE* out = std::fopen(path, "wb");
+    if (out == NULL)
+    {
+        throw_errno("fopen");
+    }
+
+    bool written = std::fwrite(file.data(), 1, file.size(), out) == file.size();
+    if (std::fclose(out) != 0 || !written)
+    {
+        throw_errno("fwrite");
+    }
+}
+
+/****** LOADING ******/
+
+SStringArchive::SStringArchive(const char* path)
+    : _map(NULL), _bytes(0), _offsets(NULL), _size(0), _is_map(false)
+{
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        throw_errno("open");
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) < 0)
+    {
+        int error = errno;
+        close(fd);
+        throw std::system_error(error, std::generic_category(), "fstat");
+    }
+
+    _bytes = info.st_size;
+    if (_bytes < sizeof(archive_header))
+    {
+        close(fd);
+        throw std::runtime_error("file is too short to be an SString archive");
+    }
+
+    void* map = mmap(NULL, _bytes, PROT_READ, MAP_PRIVATE, fd, 0);
+    int error = errno;
+    close(fd);
+    if (map == MAP_FAILED)
+    {
+        throw std::system_error(error, std::generic_category(), "mmap");
+    }
+    _map = static_cast<const char*>(map);
+
+    // From here the mapping is released with the last reference to its block,
+    // including when validation throws
+    mapping_block* block;
+    try
+    {
+        block = new mapping_block();
+    }
+    catch (...)
+    {
+        munmap(map, _bytes);
+        throw;
+    }
+    block->size = reference_manager<char>::external;
+    block->ref_count = 1;
+    block->release = unmap;
+    block->map = map;
+    block->bytes = _bytes;
+
+    reference_manager<char> owner(static_cast<char*>(map), block);
+    validate();
+
+    // The magic is the one string every archive begins with, so viewing it
+    // keeps the mapping alive without a copy
+    _file = SString(owner, _map, sizeof(archive_magic) - 1);
+
+    archive_header header;
+    std::memcpy(&header, _map, sizeof(header));
+    _offsets = reinterpret_cast<const std::uint64_t*>(_map + header.table);
+    _is_map = header.flags & map_flag;
+    _size = _is_map ? header.size / 2 : header.size;
+}
+
+SStringArchive::~SStringArchive() {}
+
+SStringArchive::size_type SStringArchive::size() const
+{
+    return _size;
+}
+
+bool SStringArchive::is_map() const
+{
+    return _is_map;
+}
+
+/****** ELEMENT ACCESS ******/
+
+SString SStringArchive::operator[](size_type index) const
+{
+    if (_is_map || index >= _size)
+    {
+        throw std::out_of_range("SStringArchive has no string at the index");
+    }
+
+    return string_at(index);
+}
+
+SString SStringArchive::key(size_type index) const
+{
+    if (!_is_map || index >= _size)
+    {
+        throw std::out_of_range("SStringArchive has no pair at the index");
+    }
+
+    return string_at(index * 2);
+}
+
+SString SStringArchive::value(size_type index) const
+{
+    if (!_is_map || index >= _size)
+    {
+        throw std::out_of_range("SStringArchive has no pair at the index");
+    }
+
+    return string_at(index * 2 + 1);
+}
+
+bool SStringArchive::find(const SString& key, SString& value) const
+{
+    size_type low = 0;
+    size_type high = _is_map ? _size : 0;
+    while (low < high)
+    {
+        size_type mid = low + (high - low) / 2;
+        int order = compare(string_at(mid * 2), key);
+        if (order == 0)
+        {
+            value = string_at(mid * 2 + 1);
+            return true;
+        }
+        if (order < 0)
+        {
+            low = mid + 1;
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+
+    return false;
+}
+
+/****** SUBROUTINES ******/
+
+SString SStringArchive::string_at(size_type index) const
+{
+    const char* record = _map + _offsets[index];
+    record_length length;
+    std::memcpy(&length, record, sizeof(length));
+
+    return SString(_file, record + sizeof(length), length);
+}
+
+void SStringArchive::validate() const
+{
+    archive_header header;
+    std::memcpy(&header, _map, sizeof(header));
+
+    if (std::memcmp(header.magic, archive_magic, sizeof(archive_magic)) != 0 ||
+        header.version != archive_version || (header.flags & ~map_flag) != 0 ||
+        header.reserved != 0)
+    {
+        throw std::runtime_error("file is not an SString archive");
+    }
+    if (header.byte_order != archive_byte_order)
+    {
+        throw std::runtime_error("SString archive was written on another kind of machine");
+    }
+
+    std::uint64_t bytes = _bytes;
+    if (header.table < sizeof(header) || header.table % 8 != 0 ||
+        header.table > bytes ||
+        header.size != (bytes - header.table) / sizeof(std::uint64_t) ||
+        (bytes - header.table) % sizeof(std::uint64_t) != 0 ||
+        ((header.flags & map_flag) && header.size % 2 != 0))
+    {
+        throw std::runtime_error("SString archive is truncated or corrupt");
+    }
+
+    if (checksum(_map + sizeof(header), _bytes - sizeof(header)) != header.checksum)
+    {
+        throw std::runtime_error("SString archive checksum mismatch");
+    }
+
+    // Every string must lie before the table and end with a terminator
+    const std::uint64_t* offsets = reinterpret_cast<const std::uint64_t*>(_map + header.table);
+    for (std::uint64_t i = 0; i < header.size; ++i)
+    {
+        std::uint64_t offset = offsets[i];
+        if (offset < sizeof(header) || offset % 8 != 0 || offset > header.table ||
+            header.table - offset < sizeof(record_length))
+        {
+            throw std::runtime_error("SString archive is truncated or corrupt");
+        }
+
+        record_length length;
+        std::memcpy(&length, _map + offset, sizeof(length));
+        if (length >= header.table - offset - sizeof(length) ||
+            length >= static_cast<reference_manager<char>::size_type>(-1) ||
+            _map[offset + sizeof(length) + length] != '\0')
+        {
+            throw std::runtime_error("SString archive is truncated or corrupt");
+        }
+    }
+}
@@ -0,0 +1,139 @@
+/*
+File: sstring_archive.h
+
+Copyright (c) 2018 Alexander DuPree
+
+This software is released as open source through the MIT License
+
+Authors: Alexander DuPree
+
+https://github.com/AlexanderJDupree/Python-Strings-for-CPP
+
+*/
+
+#ifndef SSTRING_ARCHIVE_H
+#define SSTRING_ARCHIVE_H
+
+#include <cstdint>
+#include <vector>
+#include "sstring.h"
+
+// SStringArchive stores a sequence of SStrings, or a map from SString keys to
+// SString values, in a binary file that is loaded by mapping it into memory.
+//
+// Each string is written after its length and followed by a terminator, and
+// an offset table at the end of the file locates the strings. Loading checks
+// the file's checksum and layout, then every string is a slice viewing its
+// characters in the mapping, so nothing is allocated or copied per string.
+// Map archives are sorted by key and searched in place.
+//
+// Loaded strings share one reference count with the archive, which owns the
+// mapping, so the file stays mapped until the archive and every string
+// loaded from it are destroyed. Archives use the byte order of the machine
+// that wrote them, and are rejected elsewhere.
+class SStringArchive
+{
+  public:
+
+    typedef SStringArchive      self_type;
+    typedef SString::size_type  size_type;
+
+    /****** SAVING ******/
+
+    // Writes the SStrings of range to path in order. Throws std::system_error
+    // if the file can't be written
+    template <typename Range>
+    static void save(const char* path, const Range& strings);
+
+    // Writes the pairs of SStrings of range to path, such as the entries of
+    // an SStringMap<SString> or a std::map<SString, SString>, sorted by key.
+    // Throws std::invalid_argument if a key repeats and std::system_error if
+    // the file can't be written
+    template <typename Range>
+    static void save_map(const char* path, const Range& pairs);
+
+    /****** LOADING ******/
+
+    // Maps the archive at path. Throws std::system_error if it can't be
+    // opened or mapped, and std::runtime_error if it isn't an archive written
+    // on this kind of machine or its checksum doesn't match
+    explicit SStringArchive(const char* path);
+
+    // Releases the archive's reference to the mapping, which is unmapped
+    // once no string loaded from it remains
+    ~SStringArchive();
+
+    // Returns the number of strings in a sequence, or of pairs in a map
+    size_type size() const;
+
+    // Tests if the archive holds a map
+    bool is_map() const;
+
+    /****** ELEMENT ACCESS ******/
+
+    // Returns the string at index of a sequence. Throws std::out_of_range if
+    // index is past the end, or the archive holds a map
+    SString operator [] (size_type index) const;
+
+    // Returns the key or value of the pair at index in key order. Throws
+    // std::out_of_range if index is past the end, or the archive holds a
+    // sequence
+    SString key(size_type index) const;
+    SString value(size_type index) const;
+
+    // Searches a map's keys by bisection, setting value and returning true
+    // when key is found
+    bool find(const SString& key, SString& value) const;
+
+  private:
+
+    const char* _map; // The mapped file
+    std::size_t _bytes; // The length of the mapping
+    SString _file; // Views the magic, holding a reference to the mapping
+    const std::uint64_t* _offsets; // Offset of each string's length
+    size_type _size;
+    bool _is_map;
+
+    // Writes strings, pairs of keys and values when map is set
+    static void write(const char* path, std::vector<SString>& strings, bool map);
+
+    // Returns the string whose length is at _offsets[index]
+    SString string_at(size_type index) const;
+
+    // Throws std::runtime_error unless the mapping is a valid archive
+    void validate() const;
+
+    SStringArchive(const self_type&);
+    self_type& operator=(const self_type&);
+};
+
+/*******
+Implementation Section for the SStringArchive templates.
+*******/
+
+template <typename Range>
+void SStringArchive::save(const char* path, const Range& strings)
+{
+    std::vector<SString> flat;
+    for (const SString& str : strings)
+    {
+        flat.push_back(str);
+    }
+
+    write(path, flat, false);
+}
+
+template <typename Range>
+void SStringArchive::save_map(const char* path, const Range& pairs)
+{
+    std::vector<SString> flat;
+    for (const auto& pair : pairs)
+    {
+        flat.push_back(pair.first);
+        flat.push_back(pair.second);
+    }
+
+    write(path, flat, true);
+}
+
+#endif // SSTRING_ARCHIVE_H
@@ -0,0 +1,421 @@
+/*
+File: sstring_array.cpp
+
+Copyright (c) 2018 Alexander DuPree
+
+This software is released as open source through the MIT License
+
+Authors: Alexander DuPree
+
+https://github.com/AlexanderJDupree/Python-Strings-for-CPP
+
+*/
+
+#include <algorithm>
+#include <thread>
+#include "sstring_array.h"
+
+// Calls score(i) for every index below n, split into contiguous runs of at
+// least 64 indices over up to threads threads. The calling thread scores the
+// first run
+template <typename Score>
+static void score_in_parallel(std::size_t n, unsigned threads, Score score)
+{
+    std::size_t runs = threads ? threads : std::thread::hardware_concurrency();
+    runs = std::max<std::size_t>(std::min(runs, n / 64), 1);
+    std::size_t run = (n + runs - 1) / runs;
+
+    std::vector<std::thread> workers;
+    for (std::size_t begin = run; begin < n; begin += run)
+    {
+        std::size_t end = std::min(n, begin + run);
+        workers.push_back(std::thread([begin, end, &score]() {
+            for (std::size_t i = begin; i < end; ++i)
+            {
+                score(i);
+            }
+        }));
+    }
+
+    for (std::size_t i = 0; i < std::min(n, run); ++i)
+    {
+        score(i);
+    }
+    for (std::thread& worker : workers)
+    {
+        worker.join();
+    }
+}
+
+/****** CONSTRUCTORS ******/
+
+SStringArray::SStringArray()
+    : _buffer(), _offsets(1, 0) {}
+
+SStringArray::SStringArray(std::initializer_list<const char*> values)
+{
+    build(values.begin(), values.end(), std::forward_iterator_tag());
+}
+
+/****** CAPACITY ******/
+
+SStringArray::size_type SStringArray::size() const
+{
+    return _offsets.size() - 1;
+}
+
+bool SStringArray::empty() const
+{
+    return size() == 0;
+}
+
+SStringArray::size_type SStringArray::length(size_type index) const
+{
+    // Each value is followed by its null terminator
+    return _offsets[index + 1] - _offsets[index] - 1;
+}
+
+/****** ELEMENT ACCESS ******/
+
+SString SStringArray::operator [] (size_type index) const
+{
+    SSTRING_CHECK(index < size(), throw bad_index(index));
+
+    return SString(_buffer, data(index), length(index));
+}
+
+sstring_result<SString> SStringArray::try_at(size_type index) const
+{
+    if (index >= size())
+    {
+        return sstring_result<SString>();
+    }
+
+    return SString(_buffer, data(index), length(index));
+}
+
+/****** BATCH OPERATIONS ******/
+
+SStringArray SStringArray::strip(char strip_c) const
+{
+    if (strip_c == '\0')
+    {
+        throw std::invalid_argument("null terminator cannot be used as strip seed!");
+    }
+
+    return strip(SString::char_set(strip_c));
+}
+
+SStringArray SStringArray::strip(const SString::char_set& chars) const
+{
+    std::vector<const char*> begins(size());
+    std::vector<const char*> ends(size());
+
+    for (size_type i = 0; i < size(); ++i)
+    {
+        const char* first = data(i);
+        const char* last = first + length(i);
+
+        while (first != last && chars.contains(*first))
+        {
+            ++first;
+        }
+        while (last != first && chars.contains(*(last - 1)))
+        {
+            --last;
+        }
+
+        begins[i] = first;
+        ends[i] = last;
+    }
+
+    SStringArray result;
+    result.assign(begins, ends);
+    return result;
+}
+
+SStringArray SStringArray::substring(unsigned begin, unsigned end) const
+{
+    std::vector<const char*> begins(size());
+    std::vector<const char*> ends(size());
+
+    // Bounds are validated for every value before anything is copied, the
+    // same as SString::substring the end index is inclusive
+    for (size_type i = 0; i < size(); ++i)
+    {
+        if (begin > end || begin > length(i) || end > length(i))
+        {
+            throw invalid_substring();
+        }
+
+        begins[i] = data(i) + begin;
+        ends[i] = data(i) + std::min<size_type>(end + 1, length(i));
+    }
+
+    SStringArray result;
+    result.assign(begins, ends);
+    return result;
+}
+
+SStringArray::mask_type SStringArray::is_upper() const
+{
+    mask_type result(size());
+
+    for (size_type i = 0; i < size(); ++i)
+    {
+        const unsigned char* str = (const unsigned char*)data(i);
+
+        // Branch free so the compiler can vectorize the inner loop
+        unsigned char lower = 0;
+        for (size_type j = 0, n = length(i); j < n; ++j)
+        {
+            lower |= (unsigned char)(str[j] - 'a') < 26;
+        }
+
+        result[i] = !lower;
+    }
+
+    return result;
+}
+
+SStringArray::mask_type SStringArray::isnumeric() const
+{
+    mask_type result(size());
+
+    for (size_type i = 0; i < size(); ++i)
+    {
+        const unsigned char* str = (const unsigned char*)data(i);
+        size_type n = length(i);
+
+        // Counts the characters outside each numeric alphabet, a value is
+        // numeric when any one of the alphabets covers all of its digits
+        unsigned dec = 0;
+        for (size_type j = 0; j < n; ++j)
+        {
+            dec += (unsigned char)(str[j] - '0') > 9;
+        }
+
+        bool numeric = dec == 0;
+        if (!numeric && n > 1 && str[0] == '0')
+        {
+            unsigned bin = 0;
+            unsigned oct = 0;
+            unsigned hex = 0;
+            for (size_type j = 2; j < n; ++j)
+            {
+                unsigned char c = str[j];
+                bin += (unsigned char)(c - '0') > 1;
+                oct += (unsigned char)(c - '0') > 7;
+                hex += (unsigned char)(c - '0') > 9 &&
+                       (unsigned char)((c | 0x20) - 'a') > 5;
+            }
+
+            numeric = (str[1] == 'b' && bin == 0) ||
+                      (str[1] == 'o' && oct == 0) ||
+                      (str[1] == 'x' && hex == 0);
+        }
+
+        result[i] = numeric;
+    }
+
+    return result;
+}
+
+/****** BATCH SEARCH PREDICATES ******/
+
+SStringArray::mask_type SStringArray::startswith(const SString& prefix) const
+{
+    mask_type result(size());
+
+    for (size_type i = 0; i < size(); ++i)
+    {
+        result[i] = length(i) >= prefix.length() &&
+            std::memcmp(data(i), prefix.begin(), prefix.length()) == 0;
+    }
+
+    return result;
+}
+
+SStringArray::mask_type SStringArray::endswith(const SString& suffix) const
+{
+    mask_type result(size());
+
+    for (size_type i = 0; i < size(); ++i)
+    {
+        result[i] = length(i) >= suffix.length() &&
+            std::memcmp(data(i) + length(i) - suffix.length(),
+                        suffix.begin(), suffix.length()) == 0;
+    }
+
+    return result;
+}
+
+SStringArray::mask_type SStringArray::contains(const SString& needle) const
+{
+    mask_type result(size(), needle.empty());
+    if (needle.empty())
+    {
+        return result;
+    }
+
+    const char* first = needle.begin();
+    size_type n = needle.length();
+
+    for (size_type i = 0; i < size(); ++i)
+    {
+        const char* it = data(i);
+        const char* last = it + length(i);
+
+        // memchr skips to each candidate for the needle's first character
+        while (last - it >= (std::ptrdiff_t)n)
+        {
+            it = (const char*)std::memchr(it, *first, last - it - n + 1);
+            if (!it)
+            {
+                break;
+            }
+            if (std::memcmp(it, first, n) == 0)
+            {
+                result[i] = 1;
+                break;
+            }
+            ++it;
+        }
+    }
+
+    return result;
+}
+
+/****** BATCH COMPARISONS ******/
+
+SStringArray::mask_type SStringArray::equal(const SString& str) const
+{
+    mask_type result(size());
+
+    for (size_type i = 0; i < size(); ++i)
+    {
+        result[i] = length(i) == str.length() &&
+            std::memcmp(data(i), str.begin(), str.length()) == 0;
+    }
+
+    return result;
+}
+
+SStringArray::mask_type SStringArray::not_equal(const SString& str) const
+{
+    mask_type result = equal(str);
+    for (size_type i = 0; i < result.size(); ++i)
+    {
+        result[i] ^= 1;
+    }
+    return result;
+}
+
+SStringArray::mask_type SStringArray::less(const SString& str) const
+{
+    mask_type result(size());
+
+    for (size_type i = 0; i < size(); ++i)
+    {
+        result[i] = compare(i, str) < 0;
+    }
+
+    return result;
+}
+
+SStringArray::mask_type SStringArray::greater(const SString& str) const
+{
+    mask_type result(size());
+
+    for (size_type i = 0; i < size(); ++i)
+    {
+        result[i] = compare(i, str) > 0;
+    }
+
+    return result;
+}
+
+SStringArray::mask_type SStringArray::equal(const self_type& other) const
+{
+    mask_type result(std::max(size(), other.size()));
+
+    for (size_type i = 0, n = std::min(size(), other.size()); i < n; ++i)
+    {
+        result[i] = length(i) == other.length(i) &&
+            std::memcmp(data(i), other.data(i), length(i)) == 0;
+    }
+
+    return result;
+}
+
+/****** BATCH SIMILARITY ******/
+
+std::vector<SStringArray::size_type> 
+SStringArray::levenshtein(const SString& query, size_type max, unsigned threads) const
+{
+    std::vector<size_type> result(size());
+
+    score_in_parallel(size(), threads, [&](size_type i) {
+        result[i] = SString::levenshtein(data(i), length(i), query.begin(),
+                                         query.length(), max);
+    });
+
+    return result;
+}
+
+std::vector<double> 
+SStringArray::similarity_ratio(const SString& query, unsigned threads) const
+{
+    std::vector<double> result(size());
+
+    score_in_parallel(size(), threads, [&](size_type i) {
+        result[i] = SString::similarity_ratio(data(i), length(i), query.begin(),
+                                              query.length());
+    });
+
+    return result;
+}
+
+/****** SUBROUTINES ******/
+
+const char* SStringArray::data(size_type index) const
+{
+    return _buffer.begin() + _offsets[index];
+}
+
+void SStringArray::assign(const std::vector<const char*>& begins,
+                          const std::vector<const char*>& ends)
+{
+    _offsets.assign(1, 0);
+    for (size_type i = 0; i < begins.size(); ++i)
+    {
+        _offsets.push_back(_offsets.back() + (ends[i] - begins[i]) + 1);
+    }
+
+    _buffer = SString(SString::uninitialized_tag(), _offsets.back());
+
+    char* out = _buffer._data;
+    for (size_type i = 0; i < begins.size(); ++i)
+    {
+        size_type n = ends[i] - begins[i];
+        std::memcpy(out + _offsets[i], begins[i], n);
+        out[_offsets[i] + n] = '\0';
+    }
+}
+
+int SStringArray::compare(size_type index, const SString& str) const
+{
+    size_type n = std::min(length(index), str.length());
+    int result = std::memcmp(data(index), str.begin(), n);
+
+    if (result != 0)
+    {
+        return result < 0 ? -1 : 1;
+    }
+    if (length(index) == str.length())
+    {
+        return 0;
+    }
+
+    return length(index) < str.length() ? -1 : 1;
+}
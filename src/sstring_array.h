@@ -0,0 +1,216 @@
+/*
+File: sstring_array.h
+
+Copyright (c) 2018 Alexander DuPree
+
+This software is released as open source through the MIT License
+
+Authors: Alexander DuPree
+
+https://github.com/AlexanderJDupree/Python-Strings-for-CPP
+
+*/
+
+#ifndef SSTRING_ARRAY_H
+#define SSTRING_ARRAY_H
+
+#include <vector>
+#include <initializer_list>
+#include "sstring.h"
+
+// SStringArray is an immutable column of strings. Every value is stored back
+// to back in one shared character buffer and located through an offsets
+// array, so a column of n strings costs two allocations instead of n SStrings.
+// Elements are handed out as SString slices of the shared buffer.
+class SStringArray
+{
+  public:
+
+    typedef SStringArray                self_type;
+    typedef size_t                      size_type;
+
+    // Result of a batch predicate, one byte per element holding 1 where the
+    // predicate holds and 0 elsewhere. Bytes rather than packed bits keep
+    // every store in the batch loops a plain store, and data() can be handed
+    // to other batch code
+    typedef std::vector<unsigned char>  mask_type;
+
+    /****** CONSTRUCTORS ******/
+
+    // Default construction, an empty column
+    SStringArray();
+
+    // Range construction, elements may be SStrings, c-strings or (C++17)
+    // string views
+    template <typename Range>
+    explicit SStringArray(const Range& range);
+
+    // Iterator construction, forward iterators are walked twice so the
+    // character buffer is allocated exactly once
+    template <typename InputIterator>
+    SStringArray(InputIterator first, InputIterator last);
+
+    // Initializer list construction
+    SStringArray(std::initializer_list<const char*> values);
+
+    /****** CAPACITY ******/
+
+    // Returns the number of strings in the column
+    size_type size() const;
+
+    // Tests if the column holds no strings
+    bool empty() const;
+
+    // Returns the length of the string at index
+    size_type length(size_type index) const;
+
+    /****** ELEMENT ACCESS ******/
+
+    // Returns the string at index as a slice of the column's buffer. A bad
+    // index throws bad_index when checked, see sstring_check.h
+    SString operator [] (size_type index) const;
+
+    // Returns the string at index, or nothing for a bad index. Never throws
+    sstring_result<SString> try_at(size_type index) const;
+
+    /****** BATCH OPERATIONS ******/
+
+    // Each operation applies its SString counterpart to every element of the
+    // column in one loop over the shared buffer
+
+    self_type strip(const SString::char_set& chars = 
+                    SString::char_set::whitespace()) const;
+    self_type strip(char strip_c) const;
+
+    self_type substring(unsigned begin = 0, unsigned end = 0) const;
+
+    mask_type is_upper() const;
+
+    mask_type isnumeric() const;
+
+    /****** BATCH SEARCH PREDICATES ******/
+
+    mask_type startswith(const SString& prefix) const;
+
+    mask_type endswith(const SString& suffix) const;
+
+    mask_type contains(const SString& needle) const;
+
+    /****** BATCH COMPARISONS ******/
+
+    mask_type equal(const SString& str) const;
+    mask_type not_equal(const SString& str) const;
+    mask_type less(const SString& str) const;
+    mask_type greater(const SString& str) const;
+
+    // Element-wise equality, columns of differing sizes compare false past
+    // the end of the shorter column
+    mask_type equal(const self_type& other) const;
+
+    /****** BATCH SIMILARITY ******/
+
+    // Each scores query against every element with its SString counterpart.
+    // The column is split into runs of at least 64 elements scored on up to
+    // threads threads, 0 meaning std::thread::hardware_concurrency()
+
+    std::vector<size_type> levenshtein(const SString& query,
+                                       size_type max = SString::npos,
+                                       unsigned threads = 0) const;
+
+    std::vector<double> similarity_ratio(const SString& query,
+                                         unsigned threads = 0) const;
+
+  private:
+
+    SString _buffer; // Every value back to back, each followed by a '\0'
+    std::vector<size_type> _offsets; // Value i begins at _offsets[i]
+
+    // Returns a pointer to the first character of the value at index
+    const char* data(size_type index) const;
+
+    // Builds the column from the [begin, end) character bounds of each value
+    void assign(const std::vector<const char*>& begins,
+                const std::vector<const char*>& ends);
+
+    template <typename Iterator>
+    void build(Iterator first, Iterator last, std::input_iterator_tag);
+    template <typename Iterator>
+    void build(Iterator first, Iterator last, std::forward_iterator_tag);
+
+    // Returns -1, 0 or 1 as the value at index orders before, equal to or
+    // after str
+    int compare(size_type index, const SString& str) const;
+};
+
+/*******
+Implementation Section for the SStringArray templates.
+*******/
+
+template <typename Range>
+SStringArray::SStringArray(const Range& range)
+{
+    using std::begin;
+    using std::end;
+
+    typedef typename std::iterator_traits<
+        decltype(begin(range))>::iterator_category category;
+
+    build(begin(range), end(range), category());
+}
+
+template <typename InputIterator>
+SStringArray::SStringArray(InputIterator first, InputIterator last)
+{
+    typedef typename std::iterator_traits<InputIterator>::iterator_category
+        category;
+
+    build(first, last, category());
+}
+
+template <typename Iterator>
+void SStringArray::build(Iterator first, Iterator last,
+                         std::forward_iterator_tag)
+{
+    // First pass records the offset of every value
+    _offsets.assign(1, 0);
+    for (Iterator it = first; it != last; ++it)
+    {
+        _offsets.push_back(_offsets.back() + SString::piece_length(*it) + 1);
+    }
+
+    // Second pass copies each value and its terminator into one buffer
+    _buffer = SString(SString::uninitialized_tag(), _offsets.back());
+
+    char* out = _buffer._data;
+    for (size_type i = 0; first != last; ++first, ++i)
+    {
+        size_type n = _offsets[i + 1] - _offsets[i] - 1;
+        std::memcpy(out + _offsets[i], SString::piece_data(*first), n);
+        out[_offsets[i] + n] = '\0';
+    }
+}
+
+template <typename Iterator>
+void SStringArray::build(Iterator first, Iterator last,
+                         std::input_iterator_tag)
+{
+    // Single pass iterators are gathered into a growing buffer first
+    std::vector<char> values;
+
+    _offsets.assign(1, 0);
+    for (; first != last; ++first)
+    {
+        SString::const_pointer str = SString::piece_data(*first);
+        values.insert(values.end(), str, str + SString::piece_length(*first));
+        values.push_back('\0');
+        _offsets.push_back(values.size());
+    }
+
+    _buffer = SString(SString::uninitialized_tag(), values.size());
+    if (!values.empty())
+    {
+        std::memcpy(_buffer._data, &values[0], values.size());
+    }
+}
+
+#endif // SSTRING_ARRAY_H
@@ -0,0 +1,124 @@
+/*
+File: sstring_case.cpp
+
+Copyright (c) 2018 Alexander DuPree
+
+This software is released as open source through the MIT License
+
+Authors: Alexander DuPree
+
+https://github.com/AlexanderJDupree/Python-Strings-for-CPP
+
+Description: Comparison and hashing of SStrings ignoring ASCII case, folding
+             16 characters at a time with SSE2
+
+*/
+
+#include <algorithm>
+#include "sstring.h"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+typedef SString::size_type size_type;
+
+// Returns c lowercased if it is an ASCII capital
+static inline unsigned char fold(unsigned char c)
+{
+    return c + ((unsigned)(c - 'A') < 26u) * ('a' - 'A');
+}
+
+#ifdef __SSE2__
+
+// Lowercases the ASCII capitals of 16 characters. Adding 0x3f moves 'A'
+// through 'Z' to the 26 smallest signed bytes, so one signed compare finds
+// them
+static inline __m128i fold_block(__m128i v)
+{
+    __m128i shifted = _mm_add_epi8(v, _mm_set1_epi8(0x3f));
+    __m128i upper = _mm_cmplt_epi8(shifted, _mm_set1_epi8(-128 + 26));
+    return _mm_or_si128(v, _mm_and_si128(upper, _mm_set1_epi8(0x20)));
+}
+
+#endif
+
+// Returns the index of the first of n characters at which a and b differ
+// ignoring ASCII case, or n
+static size_type mismatch_ci(const char* a, const char* b, size_type n)
+{
+    size_type i = 0;
+
+#ifdef __SSE2__
+    for (; i + 16 <= n; i += 16)
+    {
+        __m128i lhs = fold_block(_mm_loadu_si128((const __m128i*)(a + i)));
+        __m128i rhs = fold_block(_mm_loadu_si128((const __m128i*)(b + i)));
+        unsigned equal = _mm_movemask_epi8(_mm_cmpeq_epi8(lhs, rhs));
+        if (equal != 0xffff)
+        {
+            return i + __builtin_ctz(~equal);
+        }
+    }
+#endif
+
+    for (; i < n; ++i)
+    {
+        if (fold(a[i]) != fold(b[i]))
+        {
+            return i;
+        }
+    }
+
+    return n;
+}
+
+/****** CASE-INSENSITIVE COMPARISON ******/
+
+bool SString::equals_ci(const self_type& other) const
+{
+    return _length == other._length &&
+           mismatch_ci(_str, other._str, _length) == _length;
+}
+
+bool SString::equals_ci(const_pointer other) const
+{
+    return _length == len(other) && mismatch_ci(_str, other, _length) == _length;
+}
+
+int SString::compare_ci(const self_type& other) const
+{
+    size_type n = std::min(_length, other._length);
+    size_type i = mismatch_ci(_str, other._str, n);
+    if (i < n)
+    {
+        return fold(_str[i]) < fold(other._str[i]) ? -1 : 1;
+    }
+
+    return _length < other._length ? -1 : _length > other._length;
+}
+
+bool SString::startswith_ci(const self_type& prefix) const
+{
+    return _length >= prefix._length &&
+           mismatch_ci(_str, prefix._str, prefix._length) == prefix._length;
+}
+
+bool SString::startswith_ci(const_pointer prefix) const
+{
+    size_type n = len(prefix);
+    return _length >= n && mismatch_ci(_str, prefix, n) == n;
+}
+
+std::size_t SString::hash_ci() const
+{
+    // The FNV-1a hash of the lowercased characters, equal to hash() of a
+    // lowercased copy
+    unsigned long long h = fnv_offset_basis;
+    for (size_type i = 0; i < _length; ++i)
+    {
+        h = (h ^ fold(_str[i])) * fnv_prime;
+    }
+
+    return static_cast<std::size_t>(h) ? static_cast<std::size_t>(h) : 1;
+}
@@ -0,0 +1,96 @@
+/*
+File: sstring_check.h
+
+Copyright (c) 2018 Alexander DuPree
+
+This software is released as open source through the MIT License
+
+Authors: Alexander DuPree
+
+https://github.com/AlexanderJDupree/Python-Strings-for-CPP
+
+*/
+
+#ifndef SSTRING_CHECK_H
+#define SSTRING_CHECK_H
+
+#include <cassert>
+
+// Tells the compiler a condition is rarely true, on compilers that take the
+// hint
+#if defined(__GNUC__) || defined(__clang__)
+#define SSTRING_UNLIKELY(condition) __builtin_expect(!!(condition), 0)
+#else
+#define SSTRING_UNLIKELY(condition) (condition)
+#endif
+
+// SSTRING_CHECK guards the arguments of SString's accessors, such as indices
+// and character pointers. The library is built in one of two modes:
+//
+// - checked, the default: a failed check runs its report, which throws the
+//   error documented by the accessor. Checks never throw to find out whether
+//   they failed, and the try_ accessors report failures through an empty
+//   sstring_result instead of throwing.
+// - unchecked, with SSTRING_UNCHECKED defined: checks are assert()s, compiled
+//   out with NDEBUG, and bad arguments are undefined behaviour.
+//
+// Unchecked conditions are still named in an unevaluated sizeof, so what
+// they test isn't unused once NDEBUG compiles the assert() out.
+#ifdef SSTRING_UNCHECKED
+#define SSTRING_CHECK(condition, report)                                      \
+    do                                                                        \
+    {                                                                         \
+        assert(condition);                                                    \
+        (void)sizeof(condition);                                              \
+    } while (0)
+#else
+#define SSTRING_CHECK(condition, report)                                      \
+    do                                                                        \
+    {                                                                         \
+        if (SSTRING_UNLIKELY(!(condition)))                                   \
+        {                                                                     \
+            report;                                                           \
+        }                                                                     \
+    } while (0)
+#endif
+
+// The result of a try_ accessor, holding a value or nothing when the access
+// failed. Shaped like C++17's std::optional
+template <typename T>
+class sstring_result
+{
+  public:
+
+    typedef T value_type;
+
+    // An empty result
+    sstring_result() : _value(), _has_value(false) {}
+
+    // A result holding value
+    sstring_result(const T& value) : _value(value), _has_value(true) {}
+
+    // Tests if the result holds a value
+    bool has_value() const { return _has_value; }
+    explicit operator bool() const { return _has_value; }
+
+    // Returns the value, the result must hold one
+    const T& value() const
+    {
+        assert(_has_value);
+        return _value;
+    }
+    const T& operator*() const { return value(); }
+
+    // Returns the value, or fallback when the result is empty
+    T value_or(const T& fallback) const
+    {
+        return _has_value ? _value : fallback;
+    }
+
+  private:
+
+    T _value;
+    bool _has_value;
+};
+
+#endif // SSTRING_CHECK_H
@@ -0,0 +1,531 @@
+/*
+File: sstring_codec.cpp
+
+Copyright (c) 2018 Alexander DuPree
+
+This software is released as open source through the MIT License
+
+Authors: Alexander DuPree
+
+https://github.com/AlexanderJDupree/Python-Strings-for-CPP
+
+Description: SString::hex, fromhex and the base64 codecs, with SSSE3 kernels
+             selected at runtime on x86
+
+*/
+
+#include "sstring.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SSTRING_CODEC_SSSE3
+#include <tmmintrin.h>
+#endif
+
+typedef SString::size_type size_type;
+
+static const char hex_digits[] = "0123456789abcdef";
+
+// A base64 alphabet and its inverse, -1 marks characters outside it
+struct base64_alphabet
+{
+    const char* chars;
+    signed char values[256];
+
+    explicit base64_alphabet(const char* alphabet) : chars(alphabet)
+    {
+        for (unsigned c = 0; c < 256; ++c)
+        {
+            values[c] = -1;
+        }
+        for (unsigned i = 0; i < 64; ++i)
+        {
+            values[(unsigned char)alphabet[i]] = i;
+        }
+    }
+};
+
+static const base64_alphabet standard(
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/");
+static const base64_alphabet urlsafe(
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_");
+
+/****** SCALAR KERNELS ******/
+
+// Returns the value of a hex digit, or -1
+static int hex_value(char c)
+{
+    if (c >= '0' && c <= '9')
+    {
+        return c - '0';
+    }
+
+    c |= 0x20;
+    return c >= 'a' && c <= 'f' ? c - 'a' + 10 : -1;
+}
+
+static void hex_bytes(const unsigned char* in, size_type n, char* out)
+{
+    for (size_type i = 0; i < n; ++i)
+    {
+        out[2 * i] = hex_digits[in[i] >> 4];
+        out[2 * i + 1] = hex_digits[in[i] & 15];
+    }
+}
+
+// Decodes n pairs of digits, returns false at the first invalid digit
+static bool unhex_bytes(const char* in, size_type n, unsigned char* out)
+{
+    for (size_type i = 0; i < n; ++i)
+    {
+        int high = hex_value(in[2 * i]);
+        int low = hex_value(in[2 * i + 1]);
+        if (high < 0 || low < 0)
+        {
+            return false;
+        }
+        out[i] = high << 4 | low;
+    }
+
+    return true;
+}
+
+// Encodes n / 3 whole groups of 3 bytes
+static void b64_groups(const base64_alphabet& alphabet, const unsigned char* in,
+                       size_type n, char* out)
+{
+    for (size_type i = 0; i + 3 <= n; i += 3, out += 4)
+    {
+        unsigned group = in[i] << 16 | in[i + 1] << 8 | in[i + 2];
+        out[0] = alphabet.chars[group >> 18];
+        out[1] = alphabet.chars[(group >> 12) & 63];
+        out[2] = alphabet.chars[(group >> 6) & 63];
+        out[3] = alphabet.chars[group & 63];
+    }
+}
+
+// Decodes n / 4 whole groups of 4 characters without padding, returns false
+// at the first character outside the alphabet
+static bool unb64_groups(const base64_alphabet& alphabet, const char* in,
+                         size_type n, unsigned char* out)
+{
+    for (size_type i = 0; i + 4 <= n; i += 4, out += 3)
+    {
+        int a = alphabet.values[(unsigned char)in[i]];
+        int b = alphabet.values[(unsigned char)in[i + 1]];
+        int c = alphabet.values[(unsigned char)in[i + 2]];
+        int d = alphabet.values[(unsigned char)in[i + 3]];
+        if ((a | b | c | d) < 0)
+        {
+            return false;
+        }
+
+        unsigned group = a << 18 | b << 12 | c << 6 | d;
+        out[0] = group >> 16;
+        out[1] = group >> 8;
+        out[2] = group;
+    }
+
+    return true;
+}
+
+/****** SSSE3 KERNELS ******/
+
+#ifdef SSTRING_CODEC_SSSE3
+
+static bool has_ssse3()
+{
+    static const bool supported = __builtin_cpu_supports("ssse3");
+    return supported;
+}
+
+// Each block of 16 bytes is split into nibbles, which look up their digit
+// with one shuffle, and interleaved into 32 digits
+__attribute__((target("ssse3")))
+static size_type hex_bytes_ssse3(const unsigned char* in, size_type n, char* out)
+{
+    const __m128i digits = _mm_loadu_si128((const __m128i*)hex_digits);
+    const __m128i low_mask = _mm_set1_epi8(0x0f);
+
+    size_type i = 0;
+    for (; i + 16 <= n; i += 16, out += 32)
+    {
+        __m128i v = _mm_loadu_si128((const __m128i*)(in + i));
+        __m128i high = _mm_shuffle_epi8(digits,
+            _mm_and_si128(_mm_srli_epi16(v, 4), low_mask));
+        __m128i low = _mm_shuffle_epi8(digits, _mm_and_si128(v, low_mask));
+
+        _mm_storeu_si128((__m128i*)out, _mm_unpacklo_epi8(high, low));
+        _mm_storeu_si128((__m128i*)(out + 16), _mm_unpackhi_epi8(high, low));
+    }
+
+    return i;
+}
+
+// Returns the values of 16 hex digits, and in valid a mask of the lanes that
+// held one
+__attribute__((target("ssse3")))
+static inline __m128i hex_values(__m128i v, unsigned& valid)
+{
+    __m128i digit = _mm_sub_epi8(v, _mm_set1_epi8('0'));
+    __m128i letter = _mm_sub_epi8(_mm_or_si128(v, _mm_set1_epi8(0x20)),
+                                  _mm_set1_epi8('a'));
+
+    // Unsigned x <= limit is min(x, limit) == x
+    __m128i is_digit = _mm_cmpeq_epi8(_mm_min_epu8(digit, _mm_set1_epi8(9)), digit);
+    __m128i is_letter = _mm_cmpeq_epi8(_mm_min_epu8(letter, _mm_set1_epi8(5)), letter);
+
+    valid = _mm_movemask_epi8(_mm_or_si128(is_digit, is_letter));
+    return _mm_or_si128(_mm_and_si128(is_digit, digit),
+           _mm_and_si128(is_letter, _mm_add_epi8(letter, _mm_set1_epi8(10))));
+}
+
+// Decodes blocks of 32 digits, each pair is combined into high * 16 + low by
+// one multiply-add. Returns the number of bytes written, or npos at an
+// invalid digit
+__attribute__((target("ssse3")))
+static size_type unhex_bytes_ssse3(const char* in, size_type n, unsigned char* out)
+{
+    const __m128i weights = _mm_set1_epi16(0x0110);
+
+    size_type i = 0;
+    for (; i + 16 <= n; i += 16)
+    {
+        unsigned first_valid, second_valid;
+        __m128i first = hex_values(
+            _mm_loadu_si128((const __m128i*)(in + 2 * i)), first_valid);
+        __m128i second = hex_values(
+            _mm_loadu_si128((const __m128i*)(in + 2 * i + 16)), second_valid);
+
+        if ((first_valid & second_valid) != 0xffff)
+        {
+            return SString::npos;
+        }
+
+        __m128i bytes = _mm_packus_epi16(_mm_maddubs_epi16(first, weights),
+                                         _mm_maddubs_epi16(second, weights));
+        _mm_storeu_si128((__m128i*)(out + i), bytes);
+    }
+
+    return i;
+}
+
+// Maps 16 sextets to their characters. Sextets are reduced to a row of an
+// offset table, 0-25 to row 13, 26-51 to row 0 and 52-63 to rows 1-12,
+// whose offset is added to the sextet
+__attribute__((target("ssse3")))
+static inline __m128i b64_chars(__m128i sextets, __m128i offsets)
+{
+    __m128i rows = _mm_subs_epu8(sextets, _mm_set1_epi8(51));
+    __m128i upper = _mm_cmpgt_epi8(_mm_set1_epi8(26), sextets);
+    rows = _mm_or_si128(rows, _mm_and_si128(upper, _mm_set1_epi8(13)));
+    return _mm_add_epi8(sextets, _mm_shuffle_epi8(offsets, rows));
+}
+
+// Encodes blocks of 12 bytes into 16 characters. Each group of 3 bytes is
+// spread over a 32-bit lane and its 4 sextets moved into their own bytes by
+// two multiplies. Blocks are loaded 16 bytes at a time, so the last 4 bytes
+// are left to the scalar loop
+__attribute__((target("ssse3")))
+static size_type b64_groups_ssse3(const base64_alphabet& alphabet,
+                                  const unsigned char* in, size_type n, char* out)
+{
+    const __m128i spread = _mm_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4,
+                                         7, 6, 8, 7, 10, 9, 11, 10);
+    const __m128i offsets = _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52,
+                                          '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                                          '0' - 52, '0' - 52, '0' - 52,
+                                          alphabet.chars[62] - 62,
+                                          alphabet.chars[63] - 63, 'A', 0, 0);
+
+    size_type i = 0;
+    for (; i + 16 <= n; i += 12, out += 16)
+    {
+        __m128i v = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(in + i)),
+                                     spread);
+
+        __m128i ac = _mm_mulhi_epu16(_mm_and_si128(v, _mm_set1_epi32(0x0fc0fc00)),
+                                     _mm_set1_epi32(0x04000040));
+        __m128i bd = _mm_mullo_epi16(_mm_and_si128(v, _mm_set1_epi32(0x003f03f0)),
+                                     _mm_set1_epi32(0x01000010));
+
+        _mm_storeu_si128((__m128i*)out, b64_chars(_mm_or_si128(ac, bd), offsets));
+    }
+
+    return i;
+}
+
+// Decodes blocks of 16 characters into 12 bytes. Characters are validated by
+// looking up a bit per low nibble and per high nibble, which only share a bit
+// for characters outside the alphabet. The url safe characters are swapped
+// for '+' and '/' first, after checking those aren't present. Each 16-byte
+// store writes 4 bytes past the block, so stops where out_end is too close.
+// Returns the number of characters read, or npos at an invalid character
+__attribute__((target("ssse3")))
+static size_type unb64_groups_ssse3(const base64_alphabet& alphabet,
+                                    const char* in, size_type n,
+                                    unsigned char* out, unsigned char* out_end)
+{
+    const __m128i low_lut = _mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11,
+                                          0x11, 0x11, 0x11, 0x11, 0x13, 0x1a,
+                                          0x1b, 0x1b, 0x1b, 0x1a);
+    const __m128i high_lut = _mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08,
+                                           0x04, 0x08, 0x10, 0x10, 0x10, 0x10,
+                                           0x10, 0x10, 0x10, 0x10);
+    const __m128i roll_lut = _mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71,
+                                           0, 0, 0, 0, 0, 0, 0, 0);
+    const __m128i nibble_mask = _mm_set1_epi8(0x2f);
+    const __m128i pack = _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12,
+                                       -1, -1, -1, -1);
+    const bool url = alphabet.chars[62] != '+';
+
+    size_type i = 0;
+    for (; i + 16 <= n && out_end - out >= 16; i += 16, out += 12)
+    {
+        __m128i v = _mm_loadu_si128((const __m128i*)(in + i));
+
+        if (url)
+        {
+            __m128i plus = _mm_cmpeq_epi8(v, _mm_set1_epi8('+'));
+            __m128i slash = _mm_cmpeq_epi8(v, _mm_set1_epi8('/'));
+            if (_mm_movemask_epi8(_mm_or_si128(plus, slash)))
+            {
+                return SString::npos;
+            }
+
+            __m128i minus = _mm_cmpeq_epi8(v, _mm_set1_epi8('-'));
+            __m128i underscore = _mm_cmpeq_epi8(v, _mm_set1_epi8('_'));
+            v = _mm_add_epi8(v, _mm_and_si128(minus, _mm_set1_epi8('+' - '-')));
+            v = _mm_add_epi8(v, _mm_and_si128(underscore, _mm_set1_epi8('/' - '_')));
+        }
+
+        __m128i high_nibbles = _mm_and_si128(_mm_srli_epi32(v, 4), nibble_mask);
+        __m128i low = _mm_shuffle_epi8(low_lut, _mm_and_si128(v, nibble_mask));
+        __m128i high = _mm_shuffle_epi8(high_lut, high_nibbles);
+
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(low, high),
+                                             _mm_setzero_si128())) != 0xffff)
+        {
+            return SString::npos;
+        }
+
+        __m128i slashes = _mm_cmpeq_epi8(v, _mm_set1_epi8('/'));
+        __m128i roll = _mm_shuffle_epi8(roll_lut, _mm_add_epi8(slashes, high_nibbles));
+        __m128i sextets = _mm_add_epi8(v, roll);
+
+        // Pairs of sextets are merged into 12 bits, then pairs of those into
+        // 24, leaving each group's 3 bytes reversed in a 32-bit lane
+        __m128i merged = _mm_maddubs_epi16(sextets, _mm_set1_epi32(0x01400140));
+        merged = _mm_madd_epi16(merged, _mm_set1_epi32(0x00011000));
+
+        _mm_storeu_si128((__m128i*)out, _mm_shuffle_epi8(merged, pack));
+    }
+
+    return i;
+}
+
+#endif // SSTRING_CODEC_SSSE3
+
+/****** HEX ******/
+
+SString SString::hex() const
+{
+    SString result(uninitialized_tag(), _length * 2);
+    const unsigned char* in = (const unsigned char*)_str;
+    size_type done = 0;
+
+#ifdef SSTRING_CODEC_SSSE3
+    if (has_ssse3())
+    {
+        done = hex_bytes_ssse3(in, _length, result._data);
+    }
+#endif
+
+    hex_bytes(in + done, _length - done, result._data + 2 * done);
+    return result;
+}
+
+bool SString::fromhex(const SString& text, SString& bytes)
+{
+    if (text._length % 2)
+    {
+        return false;
+    }
+
+    size_type n = text._length / 2;
+    SString result(uninitialized_tag(), n);
+    unsigned char* out = (unsigned char*)result._data;
+    size_type done = 0;
+
+#ifdef SSTRING_CODEC_SSSE3
+    if (has_ssse3())
+    {
+        done = unhex_bytes_ssse3(text._str, n, out);
+        if (done == npos)
+        {
+            return false;
+        }
+    }
+#endif
+
+    if (!unhex_bytes(text._str + 2 * done, n - done, out + done))
+    {
+        return false;
+    }
+
+    swap(bytes, result);
+    return true;
+}
+
+/****** BASE64 ******/
+
+// Encodes str into out, see SString::b64encode
+static void encode_b64(const SString& str, const base64_alphabet& alphabet,
+                       char* out)
+{
+    const unsigned char* in = (const unsigned char*)str.begin();
+    size_type n = str.length();
+    size_type done = 0;
+
+#ifdef SSTRING_CODEC_SSSE3
+    if (has_ssse3())
+    {
+        done = b64_groups_ssse3(alphabet, in, n, out);
+    }
+#endif
+
+    b64_groups(alphabet, in + done, n - done, out + done / 3 * 4);
+
+    // The last 1 or 2 bytes are padded to a group of 4 characters
+    size_type tail = n % 3;
+    if (tail)
+    {
+        char* last = out + n / 3 * 4;
+        unsigned group = in[n - tail] << 16 | (tail == 2 ? in[n - 1] << 8 : 0);
+        last[0] = alphabet.chars[group >> 18];
+        last[1] = alphabet.chars[(group >> 12) & 63];
+        last[2] = tail == 2 ? alphabet.chars[(group >> 6) & 63] : '=';
+        last[3] = '=';
+    }
+}
+
+SString SString::b64encode() const
+{
+    SString result(uninitialized_tag(), (_length + 2) / 3 * 4);
+    encode_b64(*this, standard, result._data);
+    return result;
+}
+
+SString SString::urlsafe_b64encode() const
+{
+    SString result(uninitialized_tag(), (_length + 2) / 3 * 4);
+    encode_b64(*this, urlsafe, result._data);
+    return result;
+}
+
+// Decodes text into the n bytes at out, see SString::b64decode
+static bool decode_b64(const SString& text, const base64_alphabet& alphabet,
+                      unsigned char* out, size_type n)
+{
+    const char* in = text.begin();
+    size_type length = text.length();
+    size_type done = 0;
+
+    // The last group may be padded, so is decoded on its own
+    size_type whole = length - 4;
+
+#ifdef SSTRING_CODEC_SSSE3
+    if (has_ssse3())
+    {
+        done = unb64_groups_ssse3(alphabet, in, whole, out, out + n);
+        if (done == SString::npos)
+        {
+            return false;
+        }
+    }
+#endif
+
+    if (!unb64_groups(alphabet, in + done, whole - done, out + done / 4 * 3))
+    {
+        return false;
+    }
+
+    char last[4] = { in[whole], in[whole + 1], in[whole + 2], in[whole + 3] };
+    size_type padding = (last[3] == '=') + (last[2] == '=');
+    if (padding == 1 || padding == 2)
+    {
+        last[3] = alphabet.chars[0];
+        last[2] = padding == 2 ? alphabet.chars[0] : last[2];
+    }
+
+    unsigned char group[3];
+    if (!unb64_groups(alphabet, last, 4, group))
+    {
+        return false;
+    }
+
+    for (size_type i = 0; i < 3 - padding; ++i)
+    {
+        out[whole / 4 * 3 + i] = group[i];
+    }
+
+    return true;
+}
+
+// Returns the number of bytes text decodes to, or npos if its length or
+// padding is invalid
+static size_type b64_decoded_length(const SString& text)
+{
+    size_type n = text.length();
+    if (n % 4)
+    {
+        return SString::npos;
+    }
+    if (n == 0)
+    {
+        return 0;
+    }
+
+    const char* last = text.begin() + n - 4;
+    if (last[2] == '=' && last[3] != '=')
+    {
+        return SString::npos;
+    }
+
+    return n / 4 * 3 - (last[3] == '=') - (last[2] == '=');
+}
+
+bool SString::b64decode(const SString& text, SString& bytes)
+{
+    size_type n = b64_decoded_length(text);
+    if (n == npos)
+    {
+        return false;
+    }
+
+    SString result(uninitialized_tag(), n);
+    if (n && !decode_b64(text, standard, (unsigned char*)result._data, n))
+    {
+        return false;
+    }
+
+    swap(bytes, result);
+    return true;
+}
+
+bool SString::urlsafe_b64decode(const SString& text, SString& bytes)
+{
+    size_type n = b64_decoded_length(text);
+    if (n == npos)
+    {
+        return false;
+    }
+
+    SString result(uninitialized_tag(), n);
+    if (n && !decode_b64(text, urlsafe, (unsigned char*)result._data, n))
+    {
+        return false;
+    }
+
+    swap(bytes, result);
+    return true;
+}
@@ -0,0 +1,255 @@
+/*
+File: sstring_crc32c.cpp
+
+Copyright (c) 2018 Alexander DuPree
+
+This software is released as open source through the MIT License
+
+Authors: Alexander DuPree
+
+https://github.com/AlexanderJDupree/Python-Strings-for-CPP
+
+Description: SString::crc32c and crc32c_update, with SSE4.2's crc32
+             instruction selected at runtime on x86-64 and a slicing-by-8
+             table fallback
+
+*/
+
+#include "sstring.h"
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#define SSTRING_CRC32C_SSE42
+#include <nmmintrin.h>
+#endif
+
+typedef SString::size_type size_type;
+
+// The Castagnoli polynomial, bit reversed
+static const std::uint32_t polynomial = 0x82f63b78;
+
+// Lengths of the blocks the hardware kernel checksums three at a time
+static const size_type long_block = 8192;
+static const size_type short_block = 256;
+
+/****** TABLES ******/
+
+// Multiplies the 32x32 matrix over GF(2) whose columns are mat by vec
+static std::uint32_t gf2_times(const std::uint32_t* mat, std::uint32_t vec)
+{
+    std::uint32_t sum = 0;
+    for (; vec; vec >>= 1, ++mat)
+    {
+        sum ^= (vec & 1) ? *mat : 0;
+    }
+    return sum;
+}
+
+static void gf2_square(std::uint32_t* square, const std::uint32_t* mat)
+{
+    for (unsigned n = 0; n < 32; ++n)
+    {
+        square[n] = gf2_times(mat, mat[n]);
+    }
+}
+
+struct crc32c_tables
+{
+    // slicing[k][b] is the CRC of byte b followed by k zero bytes
+    std::uint32_t slicing[8][256];
+
+    // The CRC of each byte of a CRC followed by a block of zeros, so
+    // combining the CRCs of consecutive blocks takes four lookups
+    std::uint32_t long_shift[4][256];
+    std::uint32_t short_shift[4][256];
+
+    crc32c_tables()
+    {
+        for (unsigned b = 0; b < 256; ++b)
+        {
+            std::uint32_t crc = b;
+            for (unsigned bit = 0; bit < 8; ++bit)
+            {
+                crc = (crc >> 1) ^ ((crc & 1) ? polynomial : 0);
+            }
+            slicing[0][b] = crc;
+        }
+        for (unsigned b = 0; b < 256; ++b)
+        {
+            for (unsigned k = 1; k < 8; ++k)
+            {
+                std::uint32_t crc = slicing[k - 1][b];
+                slicing[k][b] = (crc >> 8) ^ slicing[0][crc & 0xff];
+            }
+        }
+
+        build_shift(long_shift, long_block);
+        build_shift(short_shift, short_block);
+    }
+
+    // Builds the tables appending n zero bytes, n a power of two, by
+    // squaring the operator appending one zero bit
+    static void build_shift(std::uint32_t shift[4][256], size_type n)
+    {
+        std::uint32_t odd[32];
+        std::uint32_t even[32];
+
+        odd[0] = polynomial;
+        for (unsigned bit = 1; bit < 32; ++bit)
+        {
+            odd[bit] = 1u << (bit - 1);
+        }
+
+        // Two zero bits, then four, then a byte and doubling from there
+        gf2_square(even, odd);
+        gf2_square(odd, even);
+        std::uint32_t* op = odd;
+        for (; n; n >>= 1)
+        {
+            std::uint32_t* next = op == odd ? even : odd;
+            gf2_square(next, op);
+            op = next;
+        }
+
+        for (unsigned b = 0; b < 256; ++b)
+        {
+            for (unsigned k = 0; k < 4; ++k)
+            {
+                shift[k][b] = gf2_times(op, b << (8 * k));
+            }
+        }
+    }
+};
+
+static const crc32c_tables& tables()
+{
+    static const crc32c_tables built;
+    return built;
+}
+
+/****** TABLE KERNEL ******/
+
+// Folds 8 bytes at a time through the slicing tables, on the inverted CRC
+static std::uint32_t crc32c_table(std::uint32_t crc, const unsigned char* in,
+                                  size_type n)
+{
+    const std::uint32_t (*t)[256] = tables().slicing;
+
+    for (; n >= 8; n -= 8, in += 8)
+    {
+        crc ^= in[0] | in[1] << 8 | in[2] << 16 | (std::uint32_t)in[3] << 24;
+        crc = t[7][crc & 0xff] ^ t[6][(crc >> 8) & 0xff] ^
+              t[5][(crc >> 16) & 0xff] ^ t[4][crc >> 24] ^
+              t[3][in[4]] ^ t[2][in[5]] ^ t[1][in[6]] ^ t[0][in[7]];
+    }
+    for (; n; --n, ++in)
+    {
+        crc = (crc >> 8) ^ t[0][(crc ^ *in) & 0xff];
+    }
+
+    return crc;
+}
+
+/****** SSE4.2 KERNEL ******/
+
+#ifdef SSTRING_CRC32C_SSE42
+
+static bool has_sse42()
+{
+    static const bool supported = __builtin_cpu_supports("sse4.2");
+    return supported;
+}
+
+static inline std::uint32_t shift(const std::uint32_t table[4][256],
+                                  std::uint32_t crc)
+{
+    return table[0][crc & 0xff] ^ table[1][(crc >> 8) & 0xff] ^
+           table[2][(crc >> 16) & 0xff] ^ table[3][crc >> 24];
+}
+
+__attribute__((target("sse4.2")))
+static inline std::uint64_t load(const unsigned char* in)
+{
+    std::uint64_t word;
+    std::memcpy(&word, in, 8);
+    return word;
+}
+
+// Checksums three blocks of n bytes at once, hiding the instruction's three
+// cycle latency, then appends the second and third blocks' CRCs to the
+// first's with the shift table for n zeros
+__attribute__((target("sse4.2")))
+static inline std::uint64_t crc32c_blocks(std::uint64_t crc, const unsigned char* in,
+                                          size_type n, const std::uint32_t table[4][256])
+{
+    std::uint64_t second = 0;
+    std::uint64_t third = 0;
+    for (const unsigned char* end = in + n; in != end; in += 8)
+    {
+        crc = _mm_crc32_u64(crc, load(in));
+        second = _mm_crc32_u64(second, load(in + n));
+        third = _mm_crc32_u64(third, load(in + 2 * n));
+    }
+
+    crc = shift(table, crc) ^ second;
+    return shift(table, crc) ^ third;
+}
+
+__attribute__((target("sse4.2")))
+static std::uint32_t crc32c_sse42(std::uint32_t crc, const unsigned char* in,
+                                  size_type n)
+{
+    std::uint64_t result = crc;
+
+    if (n >= 3 * short_block)
+    {
+        const crc32c_tables& t = tables();
+        for (; n >= 3 * long_block; n -= 3 * long_block, in += 3 * long_block)
+        {
+            result = crc32c_blocks(result, in, long_block, t.long_shift);
+        }
+        for (; n >= 3 * short_block; n -= 3 * short_block, in += 3 * short_block)
+        {
+            result = crc32c_blocks(result, in, short_block, t.short_shift);
+        }
+    }
+
+    for (; n >= 8; n -= 8, in += 8)
+    {
+        result = _mm_crc32_u64(result, load(in));
+    }
+    for (; n; --n, ++in)
+    {
+        result = _mm_crc32_u8(result, *in);
+    }
+
+    return result;
+}
+
+#endif // SSTRING_CRC32C_SSE42
+
+/****** CHECKSUMS ******/
+
+std::uint32_t SString::crc32c() const
+{
+    return crc32c_update(0, _str, _length);
+}
+
+std::uint32_t SString::crc32c_update(std::uint32_t crc, const_pointer data,
+                                     size_type n)
+{
+    const unsigned char* in = (const unsigned char*)data;
+
+#ifdef SSTRING_CRC32C_SSE42
+    if (has_sse42())
+    {
+        return ~crc32c_sse42(~crc, in, n);
+    }
+#endif
+
+    return ~crc32c_table(~crc, in, n);
+}
+
+std::uint32_t SString::crc32c_update(std::uint32_t crc, const self_type& str)
+{
+    return crc32c_update(crc, str._str, str._length);
+}
@@ -0,0 +1,390 @@
+/*
+File: sstring_distance.cpp
+
+Copyright (c) 2018 Alexander DuPree
+
+This software is released as open source through the MIT License
+
+Authors: Alexander DuPree
+
+https://github.com/AlexanderJDupree/Python-Strings-for-CPP
+
+Description: Edit distance, hamming distance and difflib's similarity ratio
+             between SStrings
+
+*/
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "sstring.h"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+typedef SString::size_type size_type;
+typedef const unsigned char* bytes;
+
+/****** EDIT DISTANCE ******/
+
+// Runs the columns of the edit table for the m characters of a, m <= 64,
+// against the n characters of b in a single word. Bit i of pv and mv is set
+// where cell i + 1 of the column is one more or one less than cell i, and
+// score tracks the last cell. Returns max + 1 once the last cell can't come
+// back under max in the columns left
+static size_type myers_word(bytes a, size_type m, bytes b, size_type n, size_type max)
+{
+    std::uint64_t peq[256] = {};
+    for (size_type i = 0; i < m; ++i)
+    {
+        peq[a[i]] |= std::uint64_t(1) << i;
+    }
+
+    const std::uint64_t last = std::uint64_t(1) << (m - 1);
+    std::uint64_t pv = ~std::uint64_t(0);
+    std::uint64_t mv = 0;
+    size_type score = m;
+
+    for (size_type j = 0; j < n; ++j)
+    {
+        std::uint64_t eq = peq[b[j]];
+        std::uint64_t xv = eq | mv;
+        std::uint64_t xh = (((eq & pv) + pv) ^ pv) | eq;
+        std::uint64_t ph = mv | ~(xh | pv);
+        std::uint64_t mh = pv & xh;
+
+        score += (ph & last) ? 1 : 0;
+        score -= (mh & last) ? 1 : 0;
+
+        // The first row counts up by one each column
+        ph = (ph << 1) | 1;
+        mh <<= 1;
+        pv = mh | ~(xv | ph);
+        mv = ph & xv;
+
+        if (score > max + (n - j - 1))
+        {
+            return max + 1;
+        }
+    }
+
+    return score;
+}
+
+// myers_word for patterns longer than 64 characters, a column is a word per
+// 64 rows and each word passes its last row's horizontal delta to the next
+static size_type myers_blocks(bytes a, size_type m, bytes b, size_type n, size_type max)
+{
+    const size_type words = (m + 63) / 64;
+    std::vector<std::uint64_t> peq(256 * words);
+    for (size_type i = 0; i < m; ++i)
+    {
+        peq[a[i] * words + i / 64] |= std::uint64_t(1) << (i % 64);
+    }
+
+    const std::uint64_t high = std::uint64_t(1) << 63;
+    const std::uint64_t last = std::uint64_t(1) << ((m - 1) % 64);
+    std::vector<std::uint64_t> pvs(words, ~std::uint64_t(0));
+    std::vector<std::uint64_t> mvs(words, 0);
+    size_type score = m;
+
+    for (size_type j = 0; j < n; ++j)
+    {
+        const std::uint64_t* eqs = &peq[b[j] * words];
+
+        // Horizontal delta entering the word's first row, +1 on the first row
+        std::uint64_t carry_plus = 1;
+        std::uint64_t carry_minus = 0;
+
+        for (size_type w = 0; w < words; ++w)
+        {
+            std::uint64_t pv = pvs[w];
+            std::uint64_t mv = mvs[w];
+            std::uint64_t eq = eqs[w];
+
+            std::uint64_t xv = eq | mv;
+            eq |= carry_minus;
+            std::uint64_t xh = (((eq & pv) + pv) ^ pv) | eq;
+            std::uint64_t ph = mv | ~(xh | pv);
+            std::uint64_t mh = pv & xh;
+
+            std::uint64_t out = w + 1 == words ? last : high;
+            std::uint64_t out_plus = (ph & out) != 0;
+            std::uint64_t out_minus = (mh & out) != 0;
+
+            ph = (ph << 1) | carry_plus;
+            mh = (mh << 1) | carry_minus;
+            pvs[w] = mh | ~(xv | ph);
+            mvs[w] = ph & xv;
+
+            carry_plus = out_plus;
+            carry_minus = out_minus;
+        }
+
+        score += carry_plus;
+        score -= carry_minus;
+
+        if (score > max + (n - j - 1))
+        {
+            return max + 1;
+        }
+    }
+
+    return score;
+}
+
+// Returns the edit distance of a and b if it is at most max, else max + 1
+static size_type edit_distance(bytes a, size_type m, bytes b, size_type n, size_type max)
+{
+    // Common affixes never change the distance
+    while (m > 0 && n > 0 && *a == *b)
+    {
+        ++a; ++b; --m; --n;
+    }
+    while (m > 0 && n > 0 && a[m - 1] == b[n - 1])
+    {
+        --m; --n;
+    }
+
+    // The shorter string is the pattern, so there are fewer words per column
+    if (m > n)
+    {
+        std::swap(a, b);
+        std::swap(m, n);
+    }
+
+    if (n - m > max)
+    {
+        return max + 1;
+    }
+    if (m == 0)
+    {
+        return n;
+    }
+
+    return m <= 64 ? myers_word(a, m, b, n, max) : myers_blocks(a, m, b, n, max);
+}
+
+SString::size_type SString::levenshtein(const self_type& other) const
+{
+    return levenshtein(_str, _length, other._str, other._length, npos);
+}
+
+SString::size_type SString::levenshtein(const self_type& other, size_type max) const
+{
+    return levenshtein(_str, _length, other._str, other._length, max);
+}
+
+SString::size_type SString::levenshtein(const_pointer a, size_type m, const_pointer b,
+                                        size_type n, size_type max)
+{
+    // No distance exceeds the longer length, which keeps max + 1 in range
+    max = std::min(max, std::max(m, n));
+    return edit_distance((bytes)a, m, (bytes)b, n, max);
+}
+
+/****** HAMMING DISTANCE ******/
+
+SString::size_type SString::hamming(const self_type& other) const
+{
+    if (_length != other._length)
+    {
+        throw std::invalid_argument("hamming distance needs strings of equal length");
+    }
+
+    size_type distance = 0;
+    size_type i = 0;
+
+#ifdef __SSE2__
+    for (; i + 16 <= _length; i += 16)
+    {
+        __m128i lhs = _mm_loadu_si128((const __m128i*)(_str + i));
+        __m128i rhs = _mm_loadu_si128((const __m128i*)(other._str + i));
+        unsigned equal = _mm_movemask_epi8(_mm_cmpeq_epi8(lhs, rhs));
+        distance += 16 - __builtin_popcount(equal);
+    }
+#endif
+
+    for (; i < _length; ++i)
+    {
+        distance += _str[i] != other._str[i];
+    }
+
+    return distance;
+}
+
+/****** SIMILARITY RATIO ******/
+
+namespace
+{
+    // The state of difflib's SequenceMatcher for a pair of strings, b2j
+    // listing the positions of every byte of b except the popular ones
+    class sequence_matcher
+    {
+      public:
+
+        sequence_matcher(bytes a, size_type la, bytes b, size_type lb)
+            : _a(a), _b(b), _la(la), _lb(lb), _starts(256), _ends(256),
+              _positions(lb), _lengths(lb + 1), _next(lb + 1)
+        {
+            for (size_type j = 0; j < lb; ++j)
+            {
+                ++_ends[b[j]];
+            }
+
+            size_type start = 0;
+            for (unsigned c = 0; c < 256; ++c)
+            {
+                size_type count = _ends[c];
+                _starts[c] = _ends[c] = start;
+                start += count;
+            }
+
+            for (size_type j = 0; j < lb; ++j)
+            {
+                _positions[_ends[b[j]]++] = j;
+            }
+
+            // Bytes making up more than 1% of a b of 200 or more are popular,
+            // and ignored as junk
+            for (unsigned c = 0; lb >= 200 && c < 256; ++c)
+            {
+                if (_ends[c] - _starts[c] > lb / 100 + 1)
+                {
+                    _ends[c] = _starts[c];
+                }
+            }
+        }
+
+        // Returns the number of characters in the matching blocks
+        size_type matches()
+        {
+            size_type total = 0;
+
+            std::vector<size_type> queue { 0, _la, 0, _lb };
+            while (!queue.empty())
+            {
+                size_type bhi = queue.back(); queue.pop_back();
+                size_type blo = queue.back(); queue.pop_back();
+                size_type ahi = queue.back(); queue.pop_back();
+                size_type alo = queue.back(); queue.pop_back();
+
+                size_type i, j, k;
+                longest_match(alo, ahi, blo, bhi, i, j, k);
+                if (k == 0)
+                {
+                    continue;
+                }
+
+                total += k;
+                if (alo < i && blo < j)
+                {
+                    queue.insert(queue.end(), { alo, i, blo, j });
+                }
+                if (i + k < ahi && j + k < bhi)
+                {
+                    queue.insert(queue.end(), { i + k, ahi, j + k, bhi });
+                }
+            }
+
+            return total;
+        }
+
+      private:
+
+        bytes _a;
+        bytes _b;
+        size_type _la;
+        size_type _lb;
+        std::vector<size_type> _starts; // b2j of c is [_starts[c], _ends[c])
+        std::vector<size_type> _ends;
+        std::vector<size_type> _positions;
+
+        // j2len of difflib offset by one, _lengths[j + 1] is the length of
+        // the match ending at b[j]. The entries set are listed in _set so
+        // they are cleared without clearing the whole array
+        std::vector<size_type> _lengths;
+        std::vector<size_type> _next;
+        std::vector<size_type> _set;
+        std::vector<size_type> _next_set;
+
+        // difflib's find_longest_match, the earliest longest match of
+        // a[alo:ahi] in b[blo:bhi] extended over the junk bytes around it
+        void longest_match(size_type alo, size_type ahi, size_type blo,
+                           size_type bhi, size_type& besti, size_type& bestj,
+                           size_type& bestsize)
+        {
+            besti = alo;
+            bestj = blo;
+            bestsize = 0;
+
+            for (size_type i = alo; i < ahi; ++i)
+            {
+                _next_set.clear();
+                for (size_type p = _starts[_a[i]]; p < _ends[_a[i]]; ++p)
+                {
+                    size_type j = _positions[p];
+                    if (j < blo)
+                    {
+                        continue;
+                    }
+                    if (j >= bhi)
+                    {
+                        break;
+                    }
+
+                    size_type k = _next[j + 1] = _lengths[j] + 1;
+                    _next_set.push_back(j + 1);
+                    if (k > bestsize)
+                    {
+                        besti = i + 1 - k;
+                        bestj = j + 1 - k;
+                        bestsize = k;
+                    }
+                }
+
+                for (size_type j : _set)
+                {
+                    _lengths[j] = 0;
+                }
+                _lengths.swap(_next);
+                _set.swap(_next_set);
+            }
+            for (size_type j : _set)
+            {
+                _lengths[j] = 0;
+            }
+            _set.clear();
+
+            while (besti > alo && bestj > blo && _a[besti - 1] == _b[bestj - 1])
+            {
+                --besti; --bestj; ++bestsize;
+            }
+            while (besti + bestsize < ahi && bestj + bestsize < bhi &&
+                   _a[besti + bestsize] == _b[bestj + bestsize])
+            {
+                ++bestsize;
+            }
+        }
+    };
+}
+
+double SString::similarity_ratio(const self_type& other) const
+{
+    return similarity_ratio(_str, _length, other._str, other._length);
+}
+
+double SString::similarity_ratio(const_pointer a, size_type m, const_pointer b,
+                                 size_type n)
+{
+    if (m + n == 0)
+    {
+        return 1.0;
+    }
+
+    sequence_matcher matcher((bytes)a, m, (bytes)b, n);
+    return 2.0 * matcher.matches() / (m + n);
+}
@@ -0,0 +1,393 @@
+/*
+File: sstring_glob.cpp
+
+Copyright (c) 2018 Alexander DuPree
+
+This software is released as open source through the MIT License
+
+Authors: Alexander DuPree
+
+https://github.com/AlexanderJDupree/Python-Strings-for-CPP
+
+*/
+
+#include <algorithm>
+#include <bitset>
+#include <deque>
+#include <map>
+#include "sstring_glob.h"
+
+const SStringGlob::size_type SStringGlob::max_states;
+
+/****** CONSTRUCTORS ******/
+
+SStringGlob::SStringGlob(std::initializer_list<const char*> patterns, int flags)
+{
+    std::vector<SString::const_pointer> data;
+    std::vector<size_type> lengths;
+    for (const char* pattern : patterns)
+    {
+        data.push_back(SString::piece_data(pattern));
+        lengths.push_back(SString::len(pattern));
+    }
+
+    compile(data, lengths, flags);
+}
+
+/****** CAPACITY ******/
+
+SStringGlob::size_type SStringGlob::size() const
+{
+    return _patterns;
+}
+
+SStringGlob::size_type SStringGlob::states() const
+{
+    return _absorbing.size();
+}
+
+/****** MATCHING ******/
+
+bool SStringGlob::match(const SString& text) const
+{
+    state_type state = run(text);
+    return _accept_offsets[state] != _accept_offsets[state + 1];
+}
+
+SStringGlob::size_type SStringGlob::find(const SString& text) const
+{
+    state_type state = run(text);
+    return _accept_offsets[state] != _accept_offsets[state + 1] 
+         ? _accepts[_accept_offsets[state]] : SString::npos;
+}
+
+std::vector<SStringGlob::size_type> 
+SStringGlob::match_all(const SString& text) const
+{
+    state_type state = run(text);
+    return std::vector<size_type>(_accepts.begin() + _accept_offsets[state],
+                                  _accepts.begin() + _accept_offsets[state + 1]);
+}
+
+SStringGlob::state_type SStringGlob::run(const SString& text) const
+{
+    const unsigned char* str = (const unsigned char*)text.begin();
+    size_type n = text.length();
+
+    state_type state = _start;
+    for (size_type i = 0; i < n && !_absorbing[state]; ++i)
+    {
+        state = _transitions[state * _stride + _classes[str[i]]];
+    }
+
+    return state;
+}
+
+/****** SUBROUTINES ******/
+
+typedef std::bitset<256> byte_set;
+
+// One step of a parsed pattern, either a set of bytes matching one character
+// or a star repeating its set any number of times
+struct glob_token
+{
+    byte_set set;
+    bool star;
+};
+
+// Adds c to set, in both cases when folding case
+static void insert(byte_set& set, unsigned char c, int flags)
+{
+    set.set(c);
+    if (flags & SStringGlob::casefold)
+    {
+        if (c >= 'a' && c <= 'z') set.set(c - 'a' + 'A');
+        if (c >= 'A' && c <= 'Z') set.set(c - 'A' + 'a');
+    }
+}
+
+// Parses the bracket expression at pattern[i] == '['. Returns the index past
+// its closing ']', or i when there is none and '[' is literal
+static SStringGlob::size_type parse_bracket(SString::const_pointer pattern, 
+                                            SStringGlob::size_type i,
+                                            SStringGlob::size_type n, 
+                                            int flags, byte_set& set)
+{
+    SStringGlob::size_type j = i + 1;
+    bool negate = j < n && (pattern[j] == '!' || pattern[j] == '^');
+    j += negate;
+
+    // A ']' right after the opening bracket is part of the sequence
+    bool first = true;
+    for (; j < n && (first || pattern[j] != ']'); first = false)
+    {
+        unsigned char low = pattern[j] == '\\' && j + 1 < n ? pattern[++j] 
+                                                             : pattern[j];
+        ++j;
+
+        unsigned char high = low;
+        if (j + 1 < n && pattern[j] == '-' && pattern[j + 1] != ']')
+        {
+            j += pattern[j + 1] == '\\' && j + 2 < n ? 2 : 1;
+            high = pattern[j++];
+        }
+
+        for (unsigned c = low; c <= high; ++c)
+        {
+            insert(set, c, flags);
+        }
+    }
+
+    if (j >= n)
+    {
+        set.reset();
+        return i;
+    }
+
+    if (negate)
+    {
+        set.flip();
+    }
+    if (flags & SStringGlob::pathname)
+    {
+        set.reset('/');
+    }
+
+    return j + 1;
+}
+
+static std::vector<glob_token> parse(SString::const_pointer pattern, 
+                                     SStringGlob::size_type n, int flags)
+{
+    byte_set any;
+    any.set();
+    if (flags & SStringGlob::pathname)
+    {
+        any.reset('/');
+    }
+
+    std::vector<glob_token> tokens;
+    for (SStringGlob::size_type i = 0; i < n;)
+    {
+        glob_token token;
+        token.star = false;
+        SStringGlob::size_type next = i;
+
+        if (pattern[i] == '*')
+        {
+            // Consecutive stars are one star
+            token.set = any;
+            token.star = true;
+            while (i < n && pattern[i] == '*')
+            {
+                ++i;
+            }
+        }
+        else if (pattern[i] == '?')
+        {
+            token.set = any;
+            ++i;
+        }
+        else if (pattern[i] == '[' && 
+                 (next = parse_bracket(pattern, i, n, flags, token.set)) != i)
+        {
+            i = next;
+        }
+        else
+        {
+            // A literal, an escaped character or an unclosed '['
+            if (pattern[i] == '\\' && i + 1 < n)
+            {
+                ++i;
+            }
+            insert(token.set, pattern[i++], flags);
+        }
+
+        tokens.push_back(token);
+    }
+
+    return tokens;
+}
+
+// Every pattern's tokens are laid end to end, position p of a pattern means
+// its first p tokens have been matched. A pattern with k tokens owns k + 1
+// positions, the last accepting it
+struct glob_positions
+{
+    std::vector<glob_token> tokens; // Token at each position, empty at the last
+    std::vector<SStringGlob::size_type> accepts; // Pattern accepted, or npos
+
+    // Adds position and every position a star at it can skip to
+    void close(unsigned position, std::vector<unsigned>& set) const
+    {
+        set.push_back(position);
+        while (tokens[position].star)
+        {
+            set.push_back(++position);
+        }
+    }
+};
+
+void SStringGlob::compile(const std::vector<SString::const_pointer>& patterns,
+                          const std::vector<size_type>& lengths, int flags)
+{
+    _patterns = patterns.size();
+
+    glob_positions positions;
+    std::vector<unsigned> start;
+    for (size_type i = 0; i < patterns.size(); ++i)
+    {
+        std::vector<glob_token> tokens = parse(patterns[i], lengths[i], flags);
+        unsigned first = positions.tokens.size();
+
+        positions.tokens.insert(positions.tokens.end(), tokens.begin(), 
+                                tokens.end());
+        positions.accepts.insert(positions.accepts.end(), tokens.size(), 
+                                 SString::npos);
+
+        glob_token last;
+        last.star = false;
+        positions.tokens.push_back(last);
+        positions.accepts.push_back(i);
+
+        positions.close(first, start);
+    }
+
+    // Splits the bytes into classes that every token treats alike, a class is
+    // refined each time a token's set cuts through it
+    std::fill(_classes, _classes + 256, 0);
+    _stride = 1;
+    for (const glob_token& token : positions.tokens)
+    {
+        std::map<std::pair<unsigned, bool>, unsigned short> refined;
+        for (unsigned c = 0; c < 256; ++c)
+        {
+            refined.insert(std::make_pair(std::make_pair(_classes[c], token.set[c]),
+                                          refined.size()));
+        }
+        for (unsigned c = 0; c < 256; ++c)
+        {
+            _classes[c] = refined[std::make_pair(_classes[c], token.set[c])];
+        }
+        _stride = refined.size();
+    }
+
+    unsigned representative[256];
+    for (unsigned c = 256; c > 0; --c)
+    {
+        representative[_classes[c - 1]] = c - 1;
+    }
+
+    // Subset construction, each DFA state is a sorted set of positions. The
+    // empty set is the dead state
+    std::map<std::vector<unsigned>, state_type> ids;
+    std::vector<std::vector<unsigned> > sets(1);
+    ids[sets[0]] = dead;
+
+    std::sort(start.begin(), start.end());
+    start.erase(std::unique(start.begin(), start.end()), start.end());
+    _start = ids.insert(std::make_pair(start, 1)).first->second;
+    if (_start != dead)
+    {
+        sets.push_back(start);
+    }
+
+    _transitions.clear();
+    for (state_type state = 0; state < sets.size(); ++state)
+    {
+        for (size_type column = 0; column < _stride; ++column)
+        {
+            unsigned char c = representative[column];
+
+            std::vector<unsigned> next;
+            for (unsigned position : sets[state])
+            {
+                const glob_token& token = positions.tokens[position];
+                if (token.set[c])
+                {
+                    positions.close(position + !token.star, next);
+                }
+            }
+            std::sort(next.begin(), next.end());
+            next.erase(std::unique(next.begin(), next.end()), next.end());
+
+            auto found = ids.insert(std::make_pair(next, sets.size()));
+            if (found.second)
+            {
+                if (sets.size() == max_states)
+                {
+                    throw std::length_error("Glob patterns need too many states");
+                }
+                sets.push_back(next);
+            }
+            _transitions.push_back(found.first->second);
+        }
+    }
+
+    _accept_offsets.assign(1, 0);
+    _accepts.clear();
+    _absorbing.clear();
+    for (state_type state = 0; state < sets.size(); ++state)
+    {
+        for (unsigned position : sets[state])
+        {
+            if (positions.accepts[position] != SString::npos)
+            {
+                _accepts.push_back(positions.accepts[position]);
+            }
+        }
+        _accept_offsets.push_back(_accepts.size());
+
+        const state_type* row = &_transitions[state * _stride];
+        _absorbing.push_back(std::count(row, row + _stride, state) == 
+                             (std::ptrdiff_t)_stride);
+    }
+}
+
+bool SStringGlob::match_once(SString::const_pointer pattern, 
+                             const SString& text, int flags)
+{
+    glob_positions positions;
+    positions.tokens = parse(pattern, SString::len(pattern), flags);
+
+    glob_token last;
+    last.star = false;
+    positions.tokens.push_back(last);
+
+    // Positions reached so far. A position is marked with the step that
+    // listed it, so each is listed once per step
+    std::vector<unsigned> current;
+    std::vector<unsigned> next;
+    std::vector<size_type> marked(positions.tokens.size(), 0);
+    positions.close(0, current);
+
+    const unsigned char* str = (const unsigned char*)text.begin();
+    for (size_type i = 0; i < text.length() && !current.empty(); ++i)
+    {
+        next.clear();
+        for (unsigned position : current)
+        {
+            const glob_token& token = positions.tokens[position];
+            if (!token.set[str[i]])
+            {
+                continue;
+            }
+
+            // Like close(), stopping at a position already listed along
+            // with the ones it skips to
+            for (unsigned p = position + !token.star; marked[p] != i + 1; ++p)
+            {
+                marked[p] = i + 1;
+                next.push_back(p);
+                if (!positions.tokens[p].star)
+                {
+                    break;
+                }
+            }
+        }
+        current.swap(next);
+    }
+
+    return std::find(current.begin(), current.end(), 
+                     positions.tokens.size() - 1) != current.end();
+}
@@ -0,0 +1,141 @@
+/*
+File: sstring_glob.h
+
+Copyright (c) 2018 Alexander DuPree
+
+This software is released as open source through the MIT License
+
+Authors: Alexander DuPree
+
+https://github.com/AlexanderJDupree/Python-Strings-for-CPP
+
+*/
+
+#ifndef SSTRING_GLOB_H
+#define SSTRING_GLOB_H
+
+#include <vector>
+#include <initializer_list>
+#include "sstring.h"
+
+// SStringGlob compiles a set of shell-style wildcard patterns, as understood by
+// fnmatch, into a DFA that matches a string in one pass without backtracking.
+//
+//   *       matches any run of characters, including none
+//   ?       matches any single character
+//   [seq]   matches any character in seq, which may hold ranges such as a-z
+//   [!seq]  matches any character not in seq, [^seq] is accepted too
+//   \c      matches c literally
+//
+// A '[' without a closing ']' is matched literally. Bytes that no pattern
+// tells apart share a column of the transition table. A compiled glob is
+// immutable and may be shared between threads.
+class SStringGlob
+{
+  public:
+
+    typedef SStringGlob self_type;
+    typedef size_t      size_type;
+
+    enum options
+    {
+        none = 0,
+        pathname = 1, // Wildcards and sequences never match '/'
+        casefold = 2  // ASCII letters match either case
+    };
+
+    // Largest automaton compile() builds before throwing std::length_error.
+    // Patterns like *a???????? need a state per combination of pending
+    // characters
+    static const size_type max_states = 1 << 14;
+
+    /****** CONSTRUCTORS ******/
+
+    // Range construction, patterns may be SStrings, c-strings or (C++17)
+    // string views. Pattern ids are their positions in the range
+    template <typename Range>
+    explicit SStringGlob(const Range& patterns, int flags = none);
+
+    // Initializer list construction
+    SStringGlob(std::initializer_list<const char*> patterns, int flags = none);
+
+    /****** CAPACITY ******/
+
+    // Returns the number of patterns
+    size_type size() const;
+
+    // Returns the number of states in the automaton
+    size_type states() const;
+
+    /****** MATCHING ******/
+
+    // Tests if the whole of text matches any pattern
+    bool match(const SString& text) const;
+
+    // Returns the smallest id of a pattern matching text, or SString::npos
+    size_type find(const SString& text) const;
+
+    // Returns the ids of every pattern matching text in ascending order
+    std::vector<size_type> match_all(const SString& text) const;
+
+    // Tests if the whole of text matches pattern without compiling it, by
+    // tracking the set of pattern positions reached after each character.
+    // Slower per character than a compiled glob but never refuses a
+    // pattern, and SString::fnmatch matches single patterns with it
+    static bool match_once(SString::const_pointer pattern, const SString& text,
+                           int flags = none);
+
+  private:
+
+    typedef unsigned state_type;
+
+    // State 0 is dead, it matches nothing and never leaves itself
+    static const state_type dead = 0;
+
+    size_type _patterns; // Number of patterns
+    unsigned short _classes[256]; // Column of each byte in the table
+    size_type _stride; // Number of columns, one per byte class
+    state_type _start; // State before any character is read
+
+    // Complete DFA, the row of state s starts at s * _stride
+    std::vector<state_type> _transitions;
+
+    // Patterns accepted at state s are _accepts[_accept_offsets[s]] to
+    // _accepts[_accept_offsets[s+1]]
+    std::vector<size_type> _accept_offsets;
+    std::vector<size_type> _accepts;
+
+    // States whose every transition leads back to themselves, once reached
+    // the rest of the string can't change the result
+    std::vector<bool> _absorbing;
+
+    // Parses and compiles the automaton from each pattern's characters
+    void compile(const std::vector<SString::const_pointer>& patterns,
+                 const std::vector<size_type>& lengths, int flags);
+
+    // Returns the state reached after reading all of text
+    state_type run(const SString& text) const;
+};
+
+/*******
+Implementation Section for the SStringGlob templates.
+*******/
+
+template <typename Range>
+SStringGlob::SStringGlob(const Range& patterns, int flags)
+{
+    using std::begin;
+    using std::end;
+
+    std::vector<SString::const_pointer> data;
+    std::vector<size_type> lengths;
+    for (auto it = begin(patterns); it != end(patterns); ++it)
+    {
+        data.push_back(SString::piece_data(*it));
+        lengths.push_back(SString::piece_length(*it));
+    }
+
+    compile(data, lengths, flags);
+}
+
+#endif // SSTRING_GLOB_H
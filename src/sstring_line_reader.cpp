@@ -0,0 +1,338 @@
+/*
+File: sstring_line_reader.cpp
+
+Copyright (c) 2018 Alexander DuPree
+
+This software is released as open source through the MIT License
+
+Authors: Alexander DuPree
+
+https://github.com/AlexanderJDupree/Python-Strings-for-CPP
+
+*/
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <system_error>
+#include <vector>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include "sstring_line_reader.h"
+
+#ifdef __linux__
+#include <sys/epoll.h>
+#endif
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+// Throws the error of a failed system call
+static void throw_errno(const char* call)
+{
+    throw std::system_error(errno, std::generic_category(), call);
+}
+
+/****** CONSTRUCTORS ******/
+
+SStringLineReader::SStringLineReader(size_type chunk_size)
+    : _chunk_size(chunk_size), _epoll(-1)
+{
+    if (chunk_size == 0)
+    {
+        throw std::invalid_argument("chunk size must be positive");
+    }
+
+#ifdef __linux__
+    _epoll = epoll_create1(EPOLL_CLOEXEC);
+    if (_epoll < 0)
+    {
+        throw_errno("epoll_create1");
+    }
+#endif
+}
+
+SStringLineReader::~SStringLineReader()
+{
+    if (_epoll >= 0)
+    {
+        close(_epoll);
+    }
+}
+
+/****** DESCRIPTORS ******/
+
+void SStringLineReader::add(int fd, callback_type callback)
+{
+    if (_sources.count(fd))
+    {
+        throw std::invalid_argument("descriptor is already watched");
+    }
+
+    int flags = fcntl(fd, F_GETFL);
+    if (flags < 0 || fcntl(fd, F_SETFL, flags | O_NONBLOCK) < 0)
+    {
+        throw_errno("fcntl");
+    }
+
+    source src = { callback, SString(), 0, 0, false, false };
+
+#ifdef __linux__
+    epoll_event event = epoll_event();
+    event.events = EPOLLIN;
+    event.data.fd = fd;
+
+    // Regular files can't be waited on, they are always readable
+    if (epoll_ctl(_epoll, EPOLL_CTL_ADD, fd, &event) < 0)
+    {
+        if (errno != EPERM)
+        {
+            throw_errno("epoll_ctl");
+        }
+        src.always_ready = true;
+    }
+#endif
+
+    _sources.insert(std::make_pair(fd, src));
+}
+
+void SStringLineReader::remove(int fd)
+{
+    std::map<int, source>::iterator it = _sources.find(fd);
+    if (it == _sources.end() || it->second.removed)
+    {
+        return;
+    }
+
+    // The source is erased once no poll() is delivering its lines
+    it->second.removed = true;
+
+#ifdef __linux__
+    if (!it->second.always_ready)
+    {
+        epoll_ctl(_epoll, EPOLL_CTL_DEL, fd, NULL);
+    }
+#endif
+}
+
+SStringLineReader::size_type SStringLineReader::size() const
+{
+    size_type watched = 0;
+    for (const std::pair<const int, source>& entry : _sources)
+    {
+        watched += !entry.second.removed;
+    }
+
+    return watched;
+}
+
+/****** READING ******/
+
+SStringLineReader::size_type SStringLineReader::poll(int timeout)
+{
+    erase_removed();
+    if (_sources.empty())
+    {
+        return 0;
+    }
+
+    // Descriptors that are always readable mustn't wait on the others
+    std::vector<int> ready;
+    for (const std::pair<const int, source>& entry : _sources)
+    {
+        if (entry.second.always_ready)
+        {
+            ready.push_back(entry.first);
+        }
+    }
+    timeout = ready.empty() ? timeout : 0;
+
+#ifdef __linux__
+    epoll_event events[64];
+    int n = epoll_wait(_epoll, events, 64, ready.size() == _sources.size() ? 0 : timeout);
+    if (n < 0 && errno != EINTR)
+    {
+        throw_errno("epoll_wait");
+    }
+
+    for (int i = 0; i < n; ++i)
+    {
+        ready.push_back(events[i].data.fd);
+    }
+#else
+    std::vector<pollfd> fds;
+    for (const std::pair<const int, source>& entry : _sources)
+    {
+        pollfd fd = { entry.first, POLLIN, 0 };
+        fds.push_back(fd);
+    }
+
+    int n = ::poll(fds.data(), fds.size(), timeout);
+    if (n < 0 && errno != EINTR)
+    {
+        throw_errno("poll");
+    }
+
+    ready.clear();
+    for (int i = 0; n > 0 && i < (int)fds.size(); ++i)
+    {
+        if (fds[i].revents)
+        {
+            ready.push_back(fds[i].fd);
+        }
+    }
+#endif
+
+    for (int fd : ready)
+    {
+        std::map<int, source>::iterator it = _sources.find(fd);
+        if (it != _sources.end() && !it->second.removed)
+        {
+            read(fd, it->second);
+        }
+    }
+
+    erase_removed();
+    return _sources.size();
+}
+
+void SStringLineReader::run()
+{
+    while (poll() > 0) {}
+}
+
+/****** SUBROUTINES ******/
+
+void SStringLineReader::read(int fd, source& src)
+{
+    reserve(src);
+
+    ssize_t n = ::read(fd, src.chunk._data + src.end, src.chunk._length - src.end);
+    if (n < 0)
+    {
+        if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)
+        {
+            return;
+        }
+        throw_errno("read");
+    }
+
+    if (n == 0)
+    {
+        if (src.begin < src.end)
+        {
+            // The chunk's own terminator follows a full chunk
+            src.chunk._data[src.end] = '\0';
+            src.callback(fd, SString(src.chunk, src.chunk._data + src.begin,
+                                     src.end - src.begin));
+        }
+        remove(fd);
+        return;
+    }
+
+    size_type from = src.end;
+    src.end += n;
+    deliver(fd, src, from);
+}
+
+void SStringLineReader::reserve(source& src)
+{
+    if (src.chunk.empty())
+    {
+        src.chunk = SString(SString::uninitialized_tag(), _chunk_size);
+        return;
+    }
+
+    // Once every line of a chunk has been dropped, reading starts over at
+    // the front
+    bool unshared = src.chunk.ref_count() == 1;
+    if (unshared && src.begin == src.end)
+    {
+        src.begin = src.end = 0;
+    }
+
+    size_type capacity = src.chunk._length;
+    if (src.end < capacity)
+    {
+        return;
+    }
+
+    size_type pending = src.end - src.begin;
+    if (unshared && pending < capacity)
+    {
+        std::memmove(src.chunk._data, src.chunk._data + src.begin, pending);
+    }
+    else
+    {
+        // Delivered lines still view the chunk, or the partial line fills it
+        SString chunk(SString::uninitialized_tag(),
+                      pending == capacity ? capacity * 2 : capacity);
+        std::memcpy(chunk._data, src.chunk._data + src.begin, pending);
+        src.chunk = std::move(chunk);
+    }
+
+    src.begin = 0;
+    src.end = pending;
+}
+
+void SStringLineReader::deliver(int fd, source& src, size_type from)
+{
+    // Each newline is overwritten with a terminator for the line before it,
+    // so lines are delivered without a copy
+    char* data = src.chunk._data;
+    size_type i = from;
+
+#ifdef __SSE2__
+    // Each block of 16 bytes yields a mask of its newlines
+    const __m128i newline = _mm_set1_epi8('\n');
+    for (; i + 16 <= src.end; i += 16)
+    {
+        __m128i block = _mm_loadu_si128((const __m128i*)(data + i));
+        for (unsigned newlines = _mm_movemask_epi8(_mm_cmpeq_epi8(block, newline));
+             newlines; newlines &= newlines - 1)
+        {
+            size_type end = i + __builtin_ctz(newlines);
+            data[end] = '\0';
+            src.callback(fd, SString(src.chunk, data + src.begin, end - src.begin));
+            src.begin = end + 1;
+
+            if (src.removed)
+            {
+                return;
+            }
+        }
+    }
+#endif
+
+    for (; i < src.end; ++i)
+    {
+        if (data[i] == '\n')
+        {
+            data[i] = '\0';
+            src.callback(fd, SString(src.chunk, data + src.begin, i - src.begin));
+            src.begin = i + 1;
+
+            if (src.removed)
+            {
+                return;
+            }
+        }
+    }
+}
+
+void SStringLineReader::erase_removed()
+{
+    for (std::map<int, source>::iterator it = _sources.begin(); it != _sources.end(); )
+    {
+        if (it->second.removed)
+        {
+            _sources.erase(it++);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
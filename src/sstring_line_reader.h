@@ -0,0 +1,112 @@
+/*
+File: sstring_line_reader.h
+
+Copyright (c) 2018 Alexander DuPree
+
+This software is released as open source through the MIT License
+
+Authors: Alexander DuPree
+
+https://github.com/AlexanderJDupree/Python-Strings-for-CPP
+
+*/
+
+#ifndef SSTRING_LINE_READER_H
+#define SSTRING_LINE_READER_H
+
+#include <functional>
+#include <map>
+#include "sstring.h"
+
+// SStringLineReader reads lines from many file descriptors at once, such as
+// pipes, sockets or files being appended to. Descriptors are waited on with
+// epoll on linux and poll elsewhere, and each is read in large chunks.
+//
+// Lines are handed to a callback as slices of the chunk they were read into,
+// without their newline, so no line is copied. A chunk is reused once no
+// slice of it is left, otherwise the next read goes into a fresh chunk and
+// the old one lives on with its slices. A line longer than a chunk grows the
+// chunk to fit.
+//
+// A reader is not thread safe, poll() is meant to be the body of one thread's
+// event loop.
+class SStringLineReader
+{
+  public:
+
+    typedef SStringLineReader self_type;
+    typedef SString::size_type size_type;
+
+    // Called with the descriptor and each line read from it
+    typedef std::function<void(int fd, const SString& line)> callback_type;
+
+    /****** CONSTRUCTORS ******/
+
+    // Reads chunk_size bytes at a time. Throws std::system_error if epoll
+    // can't be set up
+    explicit SStringLineReader(size_type chunk_size = 64 * 1024);
+
+    // Closes the epoll instance, the watched descriptors are left open
+    ~SStringLineReader();
+
+    /****** DESCRIPTORS ******/
+
+    // Watches fd, switching it to non-blocking mode. Throws
+    // std::invalid_argument if fd is already watched and std::system_error if
+    // it can't be watched
+    void add(int fd, callback_type callback);
+
+    // Stops watching fd without closing it, lines read but not yet delivered
+    // are dropped. May be called from a callback
+    void remove(int fd);
+
+    // Returns the number of watched descriptors
+    size_type size() const;
+
+    /****** READING ******/
+
+    // Waits up to timeout milliseconds, forever if negative, for watched
+    // descriptors to become readable, reads a chunk from each and delivers
+    // its complete lines. At end of file the last line is delivered even
+    // without a newline and the descriptor stops being watched. Returns the
+    // number of descriptors still watched. Throws std::system_error if
+    // waiting or reading fails
+    size_type poll(int timeout = -1);
+
+    // Polls until every descriptor reaches end of file
+    void run();
+
+  private:
+
+    struct source
+    {
+        callback_type callback;
+        SString chunk; // Buffer being read into, shared with delivered lines
+        size_type begin; // Start of the line being read
+        size_type end; // End of the bytes read into chunk
+        bool removed;
+        bool always_ready; // Regular file, epoll can't wait on it
+    };
+
+    size_type _chunk_size;
+    int _epoll; // epoll instance, -1 where poll is used
+    std::map<int, source> _sources;
+
+    // Reads from a readable descriptor and delivers its lines
+    void read(int fd, source& src);
+
+    // Makes room after src.end, moving the partial line to the front of the
+    // chunk or into a new one
+    void reserve(source& src);
+
+    // Delivers the lines ending in [from, src.end)
+    void deliver(int fd, source& src, size_type from);
+
+    // Stops watching every removed descriptor
+    void erase_removed();
+
+    SStringLineReader(const self_type&);
+    self_type& operator=(const self_type&);
+};
+
+#endif // SSTRING_LINE_READER_H
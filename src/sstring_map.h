@@ -0,0 +1,924 @@
+/*
+File: sstring_map.h
+
+Copyright (c) 2018 Alexander DuPree
+
+This software is released as open source through the MIT License
+
+Authors: Alexander DuPree
+
+https://github.com/AlexanderJDupree/Python-Strings-for-CPP
+
+*/
+
+#ifndef SSTRING_MAP_H
+#define SSTRING_MAP_H
+
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "sstring.h"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+// sstring_table is the open addressing hash table behind SStringMap and
+// SStringSet, laid out like a Swiss table. Every slot has a control byte that
+// is empty, deleted, or holds 7 bits of the key's hash. Slots are probed in
+// groups of 16 whose control bytes are compared against the hash at once, so
+// most lookups touch a single slot, whose stored hash and key length are
+// checked before the key's characters.
+//
+// Keys may be looked up as SStrings, c-strings or (C++17) string views, none
+// of which builds a temporary SString. Entries are only ever keyed by
+// SStrings, an SString key is shared rather than copied.
+template <typename Entry>
+class sstring_table
+{
+  private:
+
+    struct slot;
+
+  public:
+
+    typedef std::size_t size_type;
+    typedef Entry       value_type;
+
+    // Forward iterator over the full slots, T is Entry or const Entry
+    template <typename T>
+    class table_iterator
+    {
+      public:
+
+        typedef std::forward_iterator_tag iterator_category;
+        typedef Entry                     value_type;
+        typedef std::ptrdiff_t            difference_type;
+        typedef T*                        pointer;
+        typedef T&                        reference;
+
+        table_iterator() : _table(NULL), _index(0) {}
+
+        // Iterators convert to const iterators
+        table_iterator(const table_iterator<Entry>& it)
+            : _table(it._table), _index(it._index) {}
+
+        reference operator*() const { return _table->_slots[_index].entry; }
+        pointer operator->() const { return &_table->_slots[_index].entry; }
+
+        table_iterator& operator++()
+        {
+            _index = _table->next_full(_index + 1);
+            return *this;
+        }
+
+        table_iterator operator++(int)
+        {
+            table_iterator it(*this);
+            ++*this;
+            return it;
+        }
+
+        bool operator==(const table_iterator& rhs) const
+        {
+            return _index == rhs._index;
+        }
+
+        bool operator!=(const table_iterator& rhs) const
+        {
+            return _index != rhs._index;
+        }
+
+      private:
+
+        friend class sstring_table;
+        template <typename U> friend class table_iterator;
+
+        table_iterator(const sstring_table* table, size_type index)
+            : _table(table), _index(index) {}
+
+        const sstring_table* _table;
+        size_type _index;
+    };
+
+    typedef table_iterator<Entry>       iterator;
+    typedef table_iterator<const Entry> const_iterator;
+
+    /****** CAPACITY ******/
+
+    // Returns the number of entries
+    size_type size() const { return _size; }
+
+    // Tests if there are no entries
+    bool empty() const { return _size == 0; }
+
+    // Returns the number of slots
+    size_type capacity() const { return _capacity; }
+
+    // Grows the table to hold n entries without rehashing
+    void reserve(size_type n);
+
+    // Removes every entry, keeping the slots
+    void clear();
+
+    /****** ITERATORS ******/
+
+    iterator begin() { return iterator(this, next_full(0)); }
+    iterator end() { return iterator(this, _capacity); }
+    const_iterator begin() const { return const_iterator(this, next_full(0)); }
+    const_iterator end() const { return const_iterator(this, _capacity); }
+
+  protected:
+
+    static const size_type npos = static_cast<size_type>(-1);
+
+    sstring_table();
+    sstring_table(const sstring_table& origin);
+    sstring_table(sstring_table&& origin) noexcept;
+    ~sstring_table();
+
+    sstring_table& operator=(const sstring_table& origin);
+    sstring_table& operator=(sstring_table&& origin) noexcept;
+
+    // Returns the hash of a key. Keys are hashed 8 bytes at a time rather
+    // than with SString's byte at a time FNV hash, which costs more than the
+    // rest of a lookup for all but the shortest keys
+    template <typename Key>
+    static std::size_t hash_of(const Key& key)
+    {
+        return hash_bytes(SString::piece_data(key), SString::piece_length(key));
+    }
+
+    // Returns the slot holding key, whose hash is hash, or npos
+    template <typename Key>
+    size_type find_index(const Key& key, std::size_t hash) const;
+
+    // Inserts an entry built from key and args, key must not be present.
+    // Returns the entry's slot
+    template <typename Key, typename... Args>
+    size_type insert_index(const Key& key, std::size_t hash, Args&&... args);
+
+    // Destroys the entry in slot index
+    void erase_index(size_type index);
+
+    Entry& entry(size_type index) { return _slots[index].entry; }
+    const Entry& entry(size_type index) const { return _slots[index].entry; }
+
+    // Returns an iterator to slot index, end() for npos
+    iterator iterator_at(size_type index)
+    {
+        return iterator(this, index == npos ? _capacity : index);
+    }
+    const_iterator iterator_at(size_type index) const
+    {
+        return const_iterator(this, index == npos ? _capacity : index);
+    }
+
+  private:
+
+    static const size_type group_size = 16;
+
+    // Control bytes of empty and deleted slots, full slots hold 7 hash bits
+    static const signed char empty_slot = -128;
+    static const signed char deleted_slot = -2;
+
+    struct slot
+    {
+        template <typename... Args>
+        slot(std::size_t h, Args&&... args)
+            : hash(h), entry(std::forward<Args>(args)...) {}
+
+        std::size_t hash; // hash_of the entry's key
+        Entry entry;
+    };
+
+    signed char* _ctrl; // One control byte per slot
+    slot* _slots;
+    size_type _capacity; // A multiple of group_size, a power of two
+    size_type _size; // Full slots
+    size_type _deleted; // Deleted slots, which probing steps over
+
+    static void swap(sstring_table& lhs, sstring_table& rhs);
+
+    // Returns the key of an entry
+    static const SString& key_of(const SString& entry) { return entry; }
+    template <typename V>
+    static const SString& key_of(const std::pair<const SString, V>& entry)
+    {
+        return entry.first;
+    }
+
+    // Returns an SString key, an SString is shared and anything else copied
+    static const SString& make_key(const SString& key) { return key; }
+    template <typename Key>
+    static SString make_key(const Key& key)
+    {
+        return SString(SString::piece_data(key), SString::piece_length(key));
+    }
+
+    // Multiplicative hash over 8 byte words, the final partial word is read
+    // as up to two overlapping 4 byte loads
+    static std::size_t hash_bytes(SString::const_pointer data, size_type n);
+
+    // Scrambles a hash so both its control bits and its group are taken from
+    // well mixed bits
+    static unsigned long long mix(std::size_t hash)
+    {
+        unsigned long long h = hash;
+        h ^= h >> 29;
+        h *= 0xbf58476d1ce4e5b9ull;
+        return h ^ (h >> 32);
+    }
+
+    // Masks of the slots in the group at ctrl whose control byte is h2, and
+    // that are empty, and that are empty or deleted
+    static unsigned match(const signed char* ctrl, signed char h2);
+    static unsigned match_empty(const signed char* ctrl);
+    static unsigned match_free(const signed char* ctrl);
+
+    // Returns the index of the lowest set bit of a nonzero match mask
+    static unsigned first_slot(unsigned mask);
+
+    // Returns the first empty or deleted slot on hash's probe sequence
+    size_type find_free(std::size_t hash) const;
+
+    // Returns the first full slot at or after index, or _capacity
+    size_type next_full(size_type index) const;
+
+    // Moves every entry into a table of capacity slots
+    void rehash(size_type capacity);
+};
+
+// SStringMap maps SString keys to values of type V, see sstring_table
+template <typename V>
+class SStringMap : public sstring_table<std::pair<const SString, V> >
+{
+  private:
+
+    typedef sstring_table<std::pair<const SString, V> > table_type;
+
+  public:
+
+    typedef SString                           key_type;
+    typedef V                                 mapped_type;
+    typedef std::pair<const SString, V>       value_type;
+    typedef typename table_type::iterator       iterator;
+    typedef typename table_type::const_iterator const_iterator;
+    typedef typename table_type::size_type      size_type;
+
+    /****** CONSTRUCTORS ******/
+
+    // Default construction allocates nothing until the first insertion
+    SStringMap() {}
+
+    // Inserts each key and value pair
+    SStringMap(std::initializer_list<std::pair<const char*, V> > entries);
+
+    /****** LOOKUP ******/
+
+    // Returns the entry of key, or end()
+    template <typename Key>
+    iterator find(const Key& key);
+    template <typename Key>
+    const_iterator find(const Key& key) const;
+
+    // Tests if key has an entry
+    template <typename Key>
+    bool contains(const Key& key) const;
+
+    // Returns 1 if key has an entry, otherwise 0
+    template <typename Key>
+    size_type count(const Key& key) const;
+
+    // Returns the value of key, throws std::out_of_range if there is none
+    template <typename Key>
+    V& at(const Key& key);
+    template <typename Key>
+    const V& at(const Key& key) const;
+
+    /****** MODIFIERS ******/
+
+    // Returns the value of key, inserting a default value if there is none
+    template <typename Key>
+    V& operator[](const Key& key);
+
+    // Inserts key with a value built from args unless key has an entry.
+    // Returns the entry of key and whether it was inserted
+    template <typename Key, typename... Args>
+    std::pair<iterator, bool> emplace(const Key& key, Args&&... args);
+
+    template <typename Key>
+    std::pair<iterator, bool> insert(const Key& key, const V& value);
+
+    // Removes the entry of key, returns the number of entries removed
+    template <typename Key>
+    size_type erase(const Key& key);
+};
+
+// SStringSet is a set of SStrings, see sstring_table
+class SStringSet : public sstring_table<SString>
+{
+  public:
+
+    typedef SString key_type;
+    typedef SString value_type;
+    typedef sstring_table<SString>::const_iterator iterator;
+    typedef sstring_table<SString>::const_iterator const_iterator;
+
+    /****** CONSTRUCTORS ******/
+
+    // Default construction allocates nothing until the first insertion
+    SStringSet() {}
+
+    // Inserts each key
+    SStringSet(std::initializer_list<const char*> keys);
+
+    // Inserts each element of range
+    template <typename Range>
+    explicit SStringSet(const Range& range);
+
+    /****** ITERATORS ******/
+
+    // Elements are immutable
+    const_iterator begin() const { return sstring_table<SString>::begin(); }
+    const_iterator end() const { return sstring_table<SString>::end(); }
+
+    /****** LOOKUP ******/
+
+    template <typename Key>
+    const_iterator find(const Key& key) const;
+
+    template <typename Key>
+    bool contains(const Key& key) const;
+
+    template <typename Key>
+    size_type count(const Key& key) const;
+
+    /****** MODIFIERS ******/
+
+    // Inserts key unless it is present. Returns the element equal to key and
+    // whether it was inserted
+    template <typename Key>
+    std::pair<const_iterator, bool> insert(const Key& key);
+
+    // Removes key, returns the number of elements removed
+    template <typename Key>
+    size_type erase(const Key& key);
+};
+
+/*******
+Implementation Section for the sstring_table templates.
+*******/
+
+template <typename Entry>
+const typename sstring_table<Entry>::size_type sstring_table<Entry>::npos;
+
+template <typename Entry>
+const typename sstring_table<Entry>::size_type sstring_table<Entry>::group_size;
+
+template <typename Entry>
+const signed char sstring_table<Entry>::empty_slot;
+
+template <typename Entry>
+const signed char sstring_table<Entry>::deleted_slot;
+
+template <typename Entry>
+sstring_table<Entry>::sstring_table()
+    : _ctrl(NULL), _slots(NULL), _capacity(0), _size(0), _deleted(0) {}
+
+template <typename Entry>
+sstring_table<Entry>::sstring_table(const sstring_table& origin)
+    : sstring_table()
+{
+    if (origin._size == 0)
+    {
+        return;
+    }
+
+    rehash(origin._capacity);
+    for (size_type i = origin.next_full(0); i < origin._capacity;
+         i = origin.next_full(i + 1))
+    {
+        size_type index = find_free(origin._slots[i].hash);
+        new (&_slots[index]) slot(origin._slots[i].hash, origin._slots[i].entry);
+        _ctrl[index] = origin._ctrl[i];
+        ++_size;
+    }
+}
+
+template <typename Entry>
+sstring_table<Entry>::sstring_table(sstring_table&& origin) noexcept
+    : sstring_table()
+{
+    swap(*this, origin);
+}
+
+template <typename Entry>
+sstring_table<Entry>::~sstring_table()
+{
+    clear();
+    delete [] _ctrl;
+    ::operator delete(_slots);
+}
+
+template <typename Entry>
+sstring_table<Entry>& sstring_table<Entry>::operator=(const sstring_table& origin)
+{
+    sstring_table copy(origin);
+    swap(*this, copy);
+    return *this;
+}
+
+template <typename Entry>
+sstring_table<Entry>& sstring_table<Entry>::operator=(sstring_table&& origin) noexcept
+{
+    sstring_table moved(std::move(origin));
+    swap(*this, moved);
+    return *this;
+}
+
+template <typename Entry>
+void sstring_table<Entry>::swap(sstring_table& lhs, sstring_table& rhs)
+{
+    std::swap(lhs._ctrl, rhs._ctrl);
+    std::swap(lhs._slots, rhs._slots);
+    std::swap(lhs._capacity, rhs._capacity);
+    std::swap(lhs._size, rhs._size);
+    std::swap(lhs._deleted, rhs._deleted);
+}
+
+template <typename Entry>
+void sstring_table<Entry>::reserve(size_type n)
+{
+    // Tables are kept at most 7/8 full
+    size_type capacity = group_size;
+    while (capacity / 8 * 7 < n)
+    {
+        capacity *= 2;
+    }
+
+    if (capacity > _capacity)
+    {
+        rehash(capacity);
+    }
+}
+
+template <typename Entry>
+void sstring_table<Entry>::clear()
+{
+    if (_capacity == 0)
+    {
+        return;
+    }
+
+    for (size_type i = next_full(0); i < _capacity; i = next_full(i + 1))
+    {
+        _slots[i].~slot();
+    }
+
+    std::memset(_ctrl, empty_slot, _capacity);
+    _size = 0;
+    _deleted = 0;
+}
+
+template <typename Entry>
+template <typename Key>
+typename sstring_table<Entry>::size_type
+sstring_table<Entry>::find_index(const Key& key, std::size_t hash) const
+{
+    if (_size == 0)
+    {
+        return npos;
+    }
+
+    SString::const_pointer data = SString::piece_data(key);
+    size_type length = SString::piece_length(key);
+
+    unsigned long long mixed = mix(hash);
+    signed char h2 = mixed & 0x7f;
+    size_type groups = _capacity / group_size;
+    size_type group = (mixed >> 7) & (groups - 1);
+
+    // Triangular probing visits every group of a power of two table
+    for (size_type probe = 1; ; ++probe)
+    {
+        const signed char* ctrl = _ctrl + group * group_size;
+        for (unsigned matches = match(ctrl, h2); matches; matches &= matches - 1)
+        {
+            size_type index = group * group_size + first_slot(matches);
+            const SString& candidate = key_of(_slots[index].entry);
+
+            if (_slots[index].hash == hash && candidate.length() == length &&
+                std::memcmp(candidate.begin(), data, length) == 0)
+            {
+                return index;
+            }
+        }
+
+        // Insertion fills the first free slot of the probe sequence, so a
+        // key can't be past a group with an empty slot
+        if (match_empty(ctrl))
+        {
+            return npos;
+        }
+
+        group = (group + probe) & (groups - 1);
+    }
+}
+
+template <typename Entry>
+template <typename Key, typename... Args>
+typename sstring_table<Entry>::size_type
+sstring_table<Entry>::insert_index(const Key& key, std::size_t hash,
+                                   Args&&... args)
+{
+    // The key is shared or copied before rehashing, which may release the
+    // entry key refers to
+    SString owned(make_key(key));
+
+    if (_capacity == 0)
+    {
+        rehash(group_size);
+    }
+    else if (_size + _deleted + 1 > _capacity / 8 * 7)
+    {
+        // Rehashing at the same capacity drops the deleted slots when they
+        // are many
+        rehash(_size + 1 > _capacity / 16 * 7 ? _capacity * 2 : _capacity);
+    }
+
+    size_type index = find_free(hash);
+    new (&_slots[index]) slot(hash, std::move(owned), std::forward<Args>(args)...);
+
+    _deleted -= _ctrl[index] == deleted_slot;
+    _ctrl[index] = mix(hash) & 0x7f;
+    ++_size;
+
+    return index;
+}
+
+template <typename Entry>
+void sstring_table<Entry>::erase_index(size_type index)
+{
+    _slots[index].~slot();
+    --_size;
+
+    // A probe stops at a group with an empty slot, so a slot can only be
+    // emptied if its group already stops probes
+    if (match_empty(_ctrl + index / group_size * group_size))
+    {
+        _ctrl[index] = empty_slot;
+    }
+    else
+    {
+        _ctrl[index] = deleted_slot;
+        ++_deleted;
+    }
+}
+
+template <typename Entry>
+std::size_t sstring_table<Entry>::hash_bytes(SString::const_pointer data, size_type n)
+{
+    const unsigned long long k = 0x9e3779b97f4a7c15ull;
+    unsigned long long h = n * k;
+
+    for (; n >= 8; data += 8, n -= 8)
+    {
+        unsigned long long word;
+        std::memcpy(&word, data, 8);
+        h = (h ^ word) * k;
+        h ^= h >> 32;
+    }
+
+    if (n >= 4)
+    {
+        unsigned low, high;
+        std::memcpy(&low, data, 4);
+        std::memcpy(&high, data + n - 4, 4);
+        h = (h ^ ((unsigned long long)high << 32 | low)) * k;
+    }
+    else if (n > 0)
+    {
+        unsigned long long word = (unsigned char)data[0] << 16 |
+                                  (unsigned char)data[n / 2] << 8 |
+                                  (unsigned char)data[n - 1];
+        h = (h ^ word) * k;
+    }
+
+    return h ^ (h >> 32);
+}
+
+template <typename Entry>
+typename sstring_table<Entry>::size_type
+sstring_table<Entry>::find_free(std::size_t hash) const
+{
+    unsigned long long mixed = mix(hash);
+    size_type groups = _capacity / group_size;
+    size_type group = (mixed >> 7) & (groups - 1);
+
+    for (size_type probe = 1; ; ++probe)
+    {
+        unsigned free = match_free(_ctrl + group * group_size);
+        if (free)
+        {
+            return group * group_size + first_slot(free);
+        }
+
+        group = (group + probe) & (groups - 1);
+    }
+}
+
+template <typename Entry>
+typename sstring_table<Entry>::size_type
+sstring_table<Entry>::next_full(size_type index) const
+{
+    while (index < _capacity && _ctrl[index] < 0)
+    {
+        ++index;
+    }
+
+    return index;
+}
+
+template <typename Entry>
+void sstring_table<Entry>::rehash(size_type capacity)
+{
+    sstring_table table;
+    table._ctrl = new signed char[capacity];
+    table._slots = static_cast<slot*>(::operator new(capacity * sizeof(slot)));
+    table._capacity = capacity;
+    std::memset(table._ctrl, empty_slot, capacity);
+
+    for (size_type i = next_full(0); i < _capacity; i = next_full(i + 1))
+    {
+        size_type index = table.find_free(_slots[i].hash);
+        new (&table._slots[index]) slot(_slots[i].hash,
+                                        std::move(_slots[i].entry));
+        table._ctrl[index] = _ctrl[i];
+        ++table._size;
+    }
+
+    swap(*this, table);
+}
+
+#ifdef __SSE2__
+
+template <typename Entry>
+unsigned sstring_table<Entry>::match(const signed char* ctrl, signed char h2)
+{
+    __m128i group = _mm_loadu_si128((const __m128i*)ctrl);
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8(h2)));
+}
+
+template <typename Entry>
+unsigned sstring_table<Entry>::match_empty(const signed char* ctrl)
+{
+    return match(ctrl, empty_slot);
+}
+
+template <typename Entry>
+unsigned sstring_table<Entry>::match_free(const signed char* ctrl)
+{
+    // Empty and deleted slots are the only negative control bytes
+    return _mm_movemask_epi8(_mm_loadu_si128((const __m128i*)ctrl));
+}
+
+#else
+
+template <typename Entry>
+unsigned sstring_table<Entry>::match(const signed char* ctrl, signed char h2)
+{
+    unsigned mask = 0;
+    for (unsigned i = 0; i < group_size; ++i)
+    {
+        mask |= (unsigned)(ctrl[i] == h2) << i;
+    }
+
+    return mask;
+}
+
+template <typename Entry>
+unsigned sstring_table<Entry>::match_empty(const signed char* ctrl)
+{
+    return match(ctrl, empty_slot);
+}
+
+template <typename Entry>
+unsigned sstring_table<Entry>::match_free(const signed char* ctrl)
+{
+    unsigned mask = 0;
+    for (unsigned i = 0; i < group_size; ++i)
+    {
+        mask |= (unsigned)(ctrl[i] < 0) << i;
+    }
+
+    return mask;
+}
+
+#endif // __SSE2__
+
+template <typename Entry>
+unsigned sstring_table<Entry>::first_slot(unsigned mask)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctz(mask);
+#else
+    unsigned index = 0;
+    for (; !(mask & 1); mask >>= 1)
+    {
+        ++index;
+    }
+
+    return index;
+#endif
+}
+
+/*******
+Implementation Section for the SStringMap templates.
+*******/
+
+template <typename V>
+SStringMap<V>::SStringMap(std::initializer_list<std::pair<const char*, V> > entries)
+{
+    this->reserve(entries.size());
+    for (const std::pair<const char*, V>& entry : entries)
+    {
+        emplace(entry.first, entry.second);
+    }
+}
+
+template <typename V>
+template <typename Key>
+typename SStringMap<V>::iterator SStringMap<V>::find(const Key& key)
+{
+    return this->iterator_at(this->find_index(key, this->hash_of(key)));
+}
+
+template <typename V>
+template <typename Key>
+typename SStringMap<V>::const_iterator SStringMap<V>::find(const Key& key) const
+{
+    return this->iterator_at(this->find_index(key, this->hash_of(key)));
+}
+
+template <typename V>
+template <typename Key>
+bool SStringMap<V>::contains(const Key& key) const
+{
+    return this->find_index(key, this->hash_of(key)) != table_type::npos;
+}
+
+template <typename V>
+template <typename Key>
+typename SStringMap<V>::size_type SStringMap<V>::count(const Key& key) const
+{
+    return contains(key);
+}
+
+template <typename V>
+template <typename Key>
+V& SStringMap<V>::at(const Key& key)
+{
+    size_type index = this->find_index(key, this->hash_of(key));
+    if (index == table_type::npos)
+    {
+        throw std::out_of_range("SStringMap has no entry for the key");
+    }
+
+    return this->entry(index).second;
+}
+
+template <typename V>
+template <typename Key>
+const V& SStringMap<V>::at(const Key& key) const
+{
+    return const_cast<SStringMap*>(this)->at(key);
+}
+
+template <typename V>
+template <typename Key>
+V& SStringMap<V>::operator[](const Key& key)
+{
+    std::size_t hash = this->hash_of(key);
+    size_type index = this->find_index(key, hash);
+    if (index == table_type::npos)
+    {
+        index = this->insert_index(key, hash, V());
+    }
+
+    return this->entry(index).second;
+}
+
+template <typename V>
+template <typename Key, typename... Args>
+std::pair<typename SStringMap<V>::iterator, bool>
+SStringMap<V>::emplace(const Key& key, Args&&... args)
+{
+    std::size_t hash = this->hash_of(key);
+    size_type index = this->find_index(key, hash);
+    if (index != table_type::npos)
+    {
+        return std::make_pair(this->iterator_at(index), false);
+    }
+
+    index = this->insert_index(key, hash, V(std::forward<Args>(args)...));
+    return std::make_pair(this->iterator_at(index), true);
+}
+
+template <typename V>
+template <typename Key>
+std::pair<typename SStringMap<V>::iterator, bool>
+SStringMap<V>::insert(const Key& key, const V& value)
+{
+    return emplace(key, value);
+}
+
+template <typename V>
+template <typename Key>
+typename SStringMap<V>::size_type SStringMap<V>::erase(const Key& key)
+{
+    size_type index = this->find_index(key, this->hash_of(key));
+    if (index == table_type::npos)
+    {
+        return 0;
+    }
+
+    this->erase_index(index);
+    return 1;
+}
+
+/*******
+Implementation Section for the SStringSet templates.
+*******/
+
+inline SStringSet::SStringSet(std::initializer_list<const char*> keys)
+{
+    reserve(keys.size());
+    for (const char* key : keys)
+    {
+        insert(key);
+    }
+}
+
+template <typename Range>
+SStringSet::SStringSet(const Range& range)
+{
+    using std::begin;
+    using std::end;
+
+    for (auto it = begin(range); it != end(range); ++it)
+    {
+        insert(*it);
+    }
+}
+
+template <typename Key>
+SStringSet::const_iterator SStringSet::find(const Key& key) const
+{
+    return iterator_at(find_index(key, hash_of(key)));
+}
+
+template <typename Key>
+bool SStringSet::contains(const Key& key) const
+{
+    return find_index(key, hash_of(key)) != npos;
+}
+
+template <typename Key>
+SStringSet::size_type SStringSet::count(const Key& key) const
+{
+    return contains(key);
+}
+
+template <typename Key>
+std::pair<SStringSet::const_iterator, bool> SStringSet::insert(const Key& key)
+{
+    std::size_t hash = hash_of(key);
+    size_type index = find_index(key, hash);
+    if (index != npos)
+    {
+        return std::make_pair(const_iterator(iterator_at(index)), false);
+    }
+
+    index = insert_index(key, hash);
+    return std::make_pair(const_iterator(iterator_at(index)), true);
+}
+
+template <typename Key>
+SStringSet::size_type SStringSet::erase(const Key& key)
+{
+    size_type index = find_index(key, hash_of(key));
+    if (index == npos)
+    {
+        return 0;
+    }
+
+    erase_index(index);
+    return 1;
+}
+
+#endif // SSTRING_MAP_H
@@ -0,0 +1,300 @@
+/*
+File: sstring_matcher.cpp
+
+Copyright (c) 2018 Alexander DuPree
+
+This software is released as open source through the MIT License
+
+Authors: Alexander DuPree
+
+https://github.com/AlexanderJDupree/Python-Strings-for-CPP
+
+*/
+
+#include <algorithm>
+#include <deque>
+#include "sstring_matcher.h"
+
+/****** CONSTRUCTORS ******/
+
+SStringMatcher::SStringMatcher(std::initializer_list<const char*> patterns)
+{
+    std::vector<SString::const_pointer> data;
+    for (const char* pattern : patterns)
+    {
+        data.push_back(SString::piece_data(pattern));
+        _lengths.push_back(SString::len(pattern));
+    }
+
+    compile(data);
+}
+
+/****** CAPACITY ******/
+
+SStringMatcher::size_type SStringMatcher::size() const
+{
+    return _lengths.size();
+}
+
+SStringMatcher::size_type SStringMatcher::length(size_type pattern) const
+{
+    return _lengths[pattern];
+}
+
+SStringMatcher::size_type SStringMatcher::states() const
+{
+    return _transitions.size() / _stride;
+}
+
+/****** SEARCHING ******/
+
+std::vector<SStringMatcher::match>
+SStringMatcher::find_all(const SString& text) const
+{
+    std::vector<match> matches;
+    scan(text, [&matches](const match& found) { matches.push_back(found); });
+    return matches;
+}
+
+SStringMatcher::match SStringMatcher::find(const SString& text) const
+{
+    match best = { SString::npos, no_pattern };
+    if (_empty != no_pattern)
+    {
+        best.position = 0;
+        best.pattern = _empty;
+    }
+
+    size_type longest = 0;
+    for (size_type i = 0; i < size(); ++i)
+    {
+        longest = std::max(longest, _lengths[i]);
+    }
+
+    const unsigned char* str = (const unsigned char*)text.begin();
+    state_type state = 0;
+
+    // Once the scan is a whole pattern length past the best start, no later
+    // match can begin before it
+    for (size_type i = 0; i < text.length() &&
+         (best.position == SString::npos || i < best.position + longest); ++i)
+    {
+        state = next(state, str[i]);
+
+        for (size_type j = _output_offsets[state];
+             j < _output_offsets[state + 1]; ++j)
+        {
+            size_type pattern = _outputs[j];
+            size_type position = i + 1 - _lengths[pattern];
+
+            if (position < best.position || (position == best.position &&
+                _lengths[pattern] > _lengths[best.pattern]))
+            {
+                best.position = position;
+                best.pattern = pattern;
+            }
+        }
+    }
+
+    return best;
+}
+
+bool SStringMatcher::contains(const SString& text) const
+{
+    if (_empty != no_pattern)
+    {
+        return true;
+    }
+
+    const unsigned char* str = (const unsigned char*)text.begin();
+    state_type state = 0;
+
+    for (size_type i = 0; i < text.length(); ++i)
+    {
+        state = next(state, str[i]);
+        if (_output_offsets[state] != _output_offsets[state + 1])
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool SStringMatcher::match_prefix(const SString& text) const
+{
+    if (_empty != no_pattern)
+    {
+        return true;
+    }
+
+    const unsigned char* str = (const unsigned char*)text.begin();
+    state_type state = 0;
+
+    // While the text is a prefix of some pattern the automaton follows trie
+    // edges, reaching a state as deep as the characters read. A pattern of
+    // that length ending there is a prefix of the text
+    for (size_type i = 0; i < text.length(); ++i)
+    {
+        state = next(state, str[i]);
+        if (_depths[state] != i + 1)
+        {
+            return false;
+        }
+
+        for (size_type j = _output_offsets[state];
+             j < _output_offsets[state + 1]; ++j)
+        {
+            if (_lengths[_outputs[j]] == i + 1)
+            {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+bool SStringMatcher::match_suffix(const SString& text) const
+{
+    if (_empty != no_pattern)
+    {
+        return true;
+    }
+
+    const unsigned char* str = (const unsigned char*)text.begin();
+    state_type state = 0;
+
+    for (size_type i = text.length(); i > 0; --i)
+    {
+        state = _reverse[state * _stride + _classes[str[i - 1]]];
+        if (state == 0)
+        {
+            return false;
+        }
+        if (_reverse_terminal[state])
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/****** SUBROUTINES ******/
+
+void SStringMatcher::compile(const std::vector<SString::const_pointer>& patterns)
+{
+    // Bytes used by any pattern get their own column, every other byte
+    // shares column 0
+    bool used[256] = {};
+    for (size_type i = 0; i < patterns.size(); ++i)
+    {
+        for (size_type j = 0; j < _lengths[i]; ++j)
+        {
+            used[(unsigned char)patterns[i][j]] = true;
+        }
+    }
+
+    _stride = 1;
+    for (unsigned c = 0; c < 256; ++c)
+    {
+        _classes[c] = used[c] ? _stride++ : 0;
+    }
+
+    // Builds the trie, 0 marks a missing edge since no edge leads to the root
+    std::vector<std::vector<size_type> > terminals(1);
+    _transitions.assign(_stride, 0);
+    _depths.assign(1, 0);
+    _reverse.assign(_stride, 0);
+    _reverse_terminal.assign(1, false);
+    _empty = no_pattern;
+
+    for (size_type i = 0; i < patterns.size(); ++i)
+    {
+        if (_lengths[i] == 0)
+        {
+            _empty = _empty == no_pattern ? i : _empty;
+            continue;
+        }
+
+        state_type state = 0;
+        state_type reverse = 0;
+        for (size_type j = 0; j < _lengths[i]; ++j)
+        {
+            unsigned column = _classes[(unsigned char)patterns[i][j]];
+            if (_transitions[state * _stride + column] == 0)
+            {
+                _transitions[state * _stride + column] = states();
+                _transitions.resize(_transitions.size() + _stride, 0);
+                terminals.resize(terminals.size() + 1);
+                _depths.push_back(j + 1);
+            }
+            state = _transitions[state * _stride + column];
+
+            column = _classes[(unsigned char)patterns[i][_lengths[i] - j - 1]];
+            if (_reverse[reverse * _stride + column] == 0)
+            {
+                _reverse[reverse * _stride + column] = _reverse_terminal.size();
+                _reverse.resize(_reverse.size() + _stride, 0);
+                _reverse_terminal.push_back(false);
+            }
+            reverse = _reverse[reverse * _stride + column];
+        }
+
+        terminals[state].push_back(i);
+        _reverse_terminal[reverse] = true;
+    }
+
+    // Breadth first over the trie, each state's suffix link is computed from
+    // its parent's. Missing edges are filled in from the suffix link's row,
+    // which is already complete, making the table a DFA
+    std::vector<state_type> link(states(), 0);
+    std::vector<std::vector<size_type> > outputs(states());
+    std::deque<state_type> queue;
+
+    for (size_type c = 0; c < _stride; ++c)
+    {
+        if (_transitions[c])
+        {
+            queue.push_back(_transitions[c]);
+        }
+    }
+
+    while (!queue.empty())
+    {
+        state_type state = queue.front();
+        queue.pop_front();
+
+        outputs[state] = terminals[state];
+        outputs[state].insert(outputs[state].end(),
+                              outputs[link[state]].begin(),
+                              outputs[link[state]].end());
+
+        for (size_type c = 0; c < _stride; ++c)
+        {
+            state_type& child = _transitions[state * _stride + c];
+            state_type fallback = _transitions[link[state] * _stride + c];
+
+            // Rows are only completed when their state is dequeued, so a
+            // non-zero entry here is still a trie edge
+            if (child)
+            {
+                link[child] = fallback;
+                queue.push_back(child);
+            }
+            else
+            {
+                child = fallback;
+            }
+        }
+    }
+
+    _output_offsets.assign(1, 0);
+    _outputs.clear();
+    for (size_type s = 0; s < states(); ++s)
+    {
+        _outputs.insert(_outputs.end(), outputs[s].begin(), outputs[s].end());
+        _output_offsets.push_back(_outputs.size());
+    }
+}
@@ -0,0 +1,175 @@
+/*
+File: sstring_matcher.h
+
+Copyright (c) 2018 Alexander DuPree
+
+This software is released as open source through the MIT License
+
+Authors: Alexander DuPree
+
+https://github.com/AlexanderJDupree/Python-Strings-for-CPP
+
+*/
+
+#ifndef SSTRING_MATCHER_H
+#define SSTRING_MATCHER_H
+
+#include <vector>
+#include <initializer_list>
+#include "sstring.h"
+
+// SStringMatcher compiles a set of patterns into an Aho-Corasick automaton
+// that finds every occurrence of every pattern in one pass over a string.
+//
+// The automaton is a complete DFA stored as one flat transition table. Bytes
+// that appear in no pattern share a single column, so each row is only as
+// wide as the patterns' alphabet. A compiled matcher is immutable and may be
+// shared between threads.
+class SStringMatcher
+{
+  public:
+
+    typedef SStringMatcher  self_type;
+    typedef size_t          size_type;
+
+    // An occurrence of pattern starting at position in the scanned string
+    struct match
+    {
+        size_type position;
+        size_type pattern;
+    };
+
+    /****** CONSTRUCTORS ******/
+
+    // Range construction, patterns may be SStrings, c-strings or (C++17)
+    // string views. Pattern ids are their positions in the range
+    template <typename Range>
+    explicit SStringMatcher(const Range& patterns);
+
+    // Initializer list construction
+    SStringMatcher(std::initializer_list<const char*> patterns);
+
+    /****** CAPACITY ******/
+
+    // Returns the number of patterns
+    size_type size() const;
+
+    // Returns the length of a pattern
+    size_type length(size_type pattern) const;
+
+    // Returns the number of states in the automaton
+    size_type states() const;
+
+    /****** SEARCHING ******/
+
+    // Calls callback(const match&) for every occurrence of every pattern, in
+    // order of the occurrences' end positions
+    template <typename Callback>
+    void scan(const SString& text, Callback callback) const;
+
+    // Returns every occurrence of every pattern
+    std::vector<match> find_all(const SString& text) const;
+
+    // Returns the leftmost occurrence, preferring the longest pattern. The
+    // match's position is SString::npos when nothing matches
+    match find(const SString& text) const;
+
+    // Tests if any pattern occurs in text, stopping at the first occurrence
+    bool contains(const SString& text) const;
+
+    // Tests if text begins or ends with any pattern
+    bool match_prefix(const SString& text) const;
+    bool match_suffix(const SString& text) const;
+
+  private:
+
+    typedef unsigned state_type;
+
+    static const size_type no_pattern = static_cast<size_type>(-1);
+
+    unsigned short _classes[256]; // Column of each byte in the table
+    size_type _stride; // Number of columns, one per byte class
+
+    // Complete DFA, the row of state s starts at s * _stride
+    std::vector<state_type> _transitions;
+
+    // Patterns ending at state s, including those reached through suffix
+    // links, are _outputs[_output_offsets[s]] to _outputs[_output_offsets[s+1]]
+    std::vector<size_type> _output_offsets;
+    std::vector<size_type> _outputs;
+
+    // Trie of the reversed patterns for match_suffix. 0 means no edge, a
+    // state is terminal when some pattern ends there
+    std::vector<state_type> _reverse;
+    std::vector<bool> _reverse_terminal;
+
+    std::vector<size_type> _depths; // Trie depth of each state
+    std::vector<size_type> _lengths; // Length of each pattern
+    size_type _empty; // Id of an empty pattern, no_pattern if there is none
+
+    // Compiles the automaton from each pattern's characters
+    void compile(const std::vector<SString::const_pointer>& patterns);
+
+    // Returns the state reached from state on c
+    state_type next(state_type state, unsigned char c) const;
+};
+
+/*******
+Implementation Section for the SStringMatcher templates.
+*******/
+
+template <typename Range>
+SStringMatcher::SStringMatcher(const Range& patterns)
+{
+    using std::begin;
+    using std::end;
+
+    std::vector<SString::const_pointer> data;
+    for (auto it = begin(patterns); it != end(patterns); ++it)
+    {
+        data.push_back(SString::piece_data(*it));
+        _lengths.push_back(SString::piece_length(*it));
+    }
+
+    compile(data);
+}
+
+template <typename Callback>
+void SStringMatcher::scan(const SString& text, Callback callback) const
+{
+    const unsigned char* str = (const unsigned char*)text.begin();
+    size_type n = text.length();
+
+    state_type state = 0;
+    for (size_type i = 0; i < n; ++i)
+    {
+        if (_empty != no_pattern)
+        {
+            match found = { i, _empty };
+            callback(found);
+        }
+
+        state = next(state, str[i]);
+
+        for (size_type j = _output_offsets[state];
+             j < _output_offsets[state + 1]; ++j)
+        {
+            match found = { i + 1 - _lengths[_outputs[j]], _outputs[j] };
+            callback(found);
+        }
+    }
+
+    if (_empty != no_pattern)
+    {
+        match found = { n, _empty };
+        callback(found);
+    }
+}
+
+inline SStringMatcher::state_type
+SStringMatcher::next(state_type state, unsigned char c) const
+{
+    return _transitions[state * _stride + _classes[c]];
+}
+
+#endif // SSTRING_MATCHER_H
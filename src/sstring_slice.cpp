@@ -0,0 +1,163 @@
+/*
+File: sstring_slice.cpp
+
+Copyright (c) 2018 Alexander DuPree
+
+This software is released as open source through the MIT License
+
+Authors: Alexander DuPree
+
+https://github.com/AlexanderJDupree/Python-Strings-for-CPP
+
+Description: SString::slice and its strided views, with an SSSE3 reversal
+             kernel selected at runtime on x86
+
+*/
+
+#include "sstring.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SSTRING_SLICE_SSSE3
+#include <tmmintrin.h>
+#endif
+
+typedef SString::size_type size_type;
+typedef SString::difference_type difference_type;
+
+/****** SCALAR KERNELS ******/
+
+// Writes the n characters ending at last to out in reverse
+static void reverse_bytes(const char* last, size_type n, char* out)
+{
+    for (size_type i = 0; i < n; ++i)
+    {
+        out[i] = *(last - i);
+    }
+}
+
+static void gather_bytes(const char* first, difference_type step, size_type n,
+                         char* out)
+{
+    for (size_type i = 0; i < n; ++i, first += step)
+    {
+        out[i] = *first;
+    }
+}
+
+/****** SSSE3 KERNELS ******/
+
+#ifdef SSTRING_SLICE_SSSE3
+
+static bool has_ssse3()
+{
+    static const bool supported = __builtin_cpu_supports("ssse3");
+    return supported;
+}
+
+// Reverses whole blocks of 16 characters with one shuffle each, returns the
+// number of characters written
+__attribute__((target("ssse3")))
+static size_type reverse_bytes_ssse3(const char* last, size_type n, char* out)
+{
+    const __m128i reverse = _mm_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8,
+                                          7, 6, 5, 4, 3, 2, 1, 0);
+
+    size_type i = 0;
+    for (; i + 16 <= n; i += 16)
+    {
+        __m128i v = _mm_loadu_si128((const __m128i*)(last - i - 15));
+        _mm_storeu_si128((__m128i*)(out + i), _mm_shuffle_epi8(v, reverse));
+    }
+
+    return i;
+}
+
+#endif // SSTRING_SLICE_SSSE3
+
+/****** SLICING ******/
+
+// Clamps a bound as python's PySlice_AdjustIndices does
+static difference_type clamp(difference_type index, difference_type length,
+                             difference_type step)
+{
+    if (index < 0)
+    {
+        index += length;
+        return index < 0 ? (step < 0 ? -1 : 0) : index;
+    }
+
+    return index >= length ? (step < 0 ? length - 1 : length) : index;
+}
+
+SString::stride_view SString::slice(difference_type start, difference_type stop,
+                                    difference_type step) const
+{
+    if (step == 0)
+    {
+        throw std::invalid_argument("slice step cannot be zero");
+    }
+    if (step == omitted)
+    {
+        // Python's s[a:b:] steps by 1, and -omitted would overflow
+        step = 1;
+    }
+
+    difference_type length = _length;
+    if (start == omitted)
+    {
+        start = step < 0 ? length - 1 : 0;
+    }
+    else
+    {
+        start = clamp(start, length, step);
+    }
+
+    if (stop == omitted)
+    {
+        stop = step < 0 ? -1 : length;
+    }
+    else
+    {
+        stop = clamp(stop, length, step);
+    }
+
+    size_type n = 0;
+    if (step < 0 && stop < start)
+    {
+        n = (start - stop - 1) / -step + 1;
+    }
+    else if (step > 0 && start < stop)
+    {
+        n = (stop - start - 1) / step + 1;
+    }
+
+    return stride_view(*this, n ? _str + start : _str, step, n);
+}
+
+SString SString::stride_view::str() const
+{
+    if (_step == 1 || _length == 0)
+    {
+        return SString(_string, _first, _length);
+    }
+
+    SString result(uninitialized_tag(), _length);
+    size_type done = 0;
+
+    if (_step == -1)
+    {
+#ifdef SSTRING_SLICE_SSSE3
+        if (has_ssse3())
+        {
+            done = reverse_bytes_ssse3(_first, _length, result._data);
+        }
+#endif
+        reverse_bytes(_first - done, _length - done, result._data + done);
+    }
+    else
+    {
+        gather_bytes(_first, _step, _length, result._data);
+    }
+
+    return result;
+}
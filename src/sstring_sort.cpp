@@ -0,0 +1,200 @@
+/*
+File: sstring_sort.cpp
+
+Copyright (c) 2018 Alexander DuPree
+
+This software is released as open source through the MIT License
+
+Authors: Alexander DuPree
+
+https://github.com/AlexanderJDupree/Python-Strings-for-CPP
+
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <thread>
+#include "sstring_sort.h"
+
+using sstring_sort_detail::record;
+
+namespace
+{
+    typedef SString::size_type size_type;
+
+    // Buckets this small are insertion sorted
+    const size_type insertion_threshold = 16;
+
+    // Partitions this large are handed to another thread in parallel mode
+    const size_type parallel_threshold = 1 << 16;
+
+    struct context
+    {
+        bool stable;
+        bool parallel;
+        std::atomic<int> threads; // Threads that may still be started
+    };
+
+    // Returns the 8 bytes of r's string at depth as a big endian integer
+    unsigned long long load(const record& r, size_type depth)
+    {
+        unsigned long long word = 0;
+        if (depth < r.length)
+        {
+            std::memcpy(&word, r.data + depth, std::min<size_type>(r.length - depth, 8));
+        }
+
+#if defined(__GNUC__) && defined(__BYTE_ORDER__)
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+        return __builtin_bswap64(word);
+#else
+        return word;
+#endif
+#else
+        // Without the byte order macros the bytes are read back in order,
+        // which is a byte swap on little endian machines
+        unsigned char bytes[8];
+        std::memcpy(bytes, &word, 8);
+
+        word = 0;
+        for (unsigned i = 0; i < 8; ++i)
+        {
+            word = word << 8 | bytes[i];
+        }
+        return word;
+#endif
+    }
+
+    // Compares the strings of two records whose first depth bytes are equal
+    bool less(const record& lhs, const record& rhs, size_type depth, bool stable)
+    {
+        if (lhs.word != rhs.word)
+        {
+            return lhs.word < rhs.word;
+        }
+
+        size_type n = std::min(lhs.length, rhs.length);
+        int result = n > depth ? std::memcmp(lhs.data + depth, rhs.data + depth, n - depth) : 0;
+
+        if (result != 0)
+        {
+            return result < 0;
+        }
+        if (lhs.length != rhs.length)
+        {
+            return lhs.length < rhs.length;
+        }
+        return stable && lhs.index < rhs.index;
+    }
+
+    void insertion_sort(record* first, record* last, size_type depth, bool stable)
+    {
+        for (record* i = first + 1; i < last; ++i)
+        {
+            record r = *i;
+            record* j = i;
+            for (; j > first && less(r, j[-1], depth, stable); --j)
+            {
+                *j = j[-1];
+            }
+            *j = r;
+        }
+    }
+
+    const unsigned long long& median(const unsigned long long& a,
+                                     const unsigned long long& b,
+                                     const unsigned long long& c)
+    {
+        return a < b ? (b < c ? b : (a < c ? c : a))
+                     : (a < c ? a : (b < c ? c : b));
+    }
+
+    // Multikey quicksort of records whose words hold their bytes at depth
+    void sort_loaded(record* first, record* last, size_type depth, context& ctx)
+    {
+        std::thread worker;
+
+        while (static_cast<size_type>(last - first) > insertion_threshold)
+        {
+            size_type n = last - first;
+            unsigned long long pivot = median(first[0].word, first[n / 2].word,
+                                              last[-1].word);
+
+            // Three way partition on the words: [first, lt) is less than the
+            // pivot, [lt, gt) equal and [gt, last) greater
+            record* lt = first;
+            record* gt = last;
+            for (record* i = first; i < gt; )
+            {
+                if (i->word < pivot)
+                {
+                    std::swap(*lt++, *i++);
+                }
+                else if (i->word > pivot)
+                {
+                    std::swap(*i, *--gt);
+                }
+                else
+                {
+                    ++i;
+                }
+            }
+
+            if (ctx.parallel && !worker.joinable() &&
+                static_cast<size_type>(lt - first) > parallel_threshold &&
+                ctx.threads.fetch_sub(1) > 0)
+            {
+                worker = std::thread(sort_loaded, first, lt, depth, std::ref(ctx));
+            }
+            else
+            {
+                sort_loaded(first, lt, depth, ctx);
+            }
+            sort_loaded(gt, last, depth, ctx);
+
+            // Strings ending within the word are equal up to trailing null
+            // characters, and come before the longer strings sharing the word
+            record* finished = std::partition(lt, gt, [depth](const record& r) {
+                return r.length <= depth + 8;
+            });
+            std::sort(lt, finished, [&ctx](const record& lhs, const record& rhs) {
+                return lhs.length < rhs.length ||
+                       (lhs.length == rhs.length && ctx.stable && lhs.index < rhs.index);
+            });
+
+            // The rest tie on the whole word, the next 8 bytes decide
+            depth += 8;
+            for (record* i = finished; i < gt; ++i)
+            {
+                i->word = load(*i, depth);
+            }
+
+            first = finished;
+            last = gt;
+        }
+
+        insertion_sort(first, last, depth, ctx.stable);
+
+        if (worker.joinable())
+        {
+            worker.join();
+        }
+    }
+}
+
+void sstring_sort_detail::sort(std::vector<record>& records, bool stable,
+                               sstring_sort_mode mode)
+{
+    context ctx;
+    ctx.stable = stable;
+    ctx.parallel = mode == sstring_parallel;
+    ctx.threads = std::max<int>(std::thread::hardware_concurrency(), 1) - 1;
+
+    for (record& r : records)
+    {
+        r.word = load(r, 0);
+    }
+
+    sort_loaded(records.data(), records.data() + records.size(), 0, ctx);
+}
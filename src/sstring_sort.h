@@ -0,0 +1,119 @@
+/*
+File: sstring_sort.h
+
+Copyright (c) 2018 Alexander DuPree
+
+This software is released as open source through the MIT License
+
+Authors: Alexander DuPree
+
+https://github.com/AlexanderJDupree/Python-Strings-for-CPP
+
+*/
+
+#ifndef SSTRING_SORT_H
+#define SSTRING_SORT_H
+
+#include <iterator>
+#include <utility>
+#include <vector>
+#include "sstring.h"
+
+// sstring_sort and sstring_stable_sort order a range of SStrings as
+// operator< does, byte by byte with a prefix before any longer string.
+//
+// Comparison sorts chase every string's pointer on every comparison. These
+// sort an array of records instead, each holding 8 bytes of its string loaded
+// as an integer, with a multikey quicksort that partitions on those words and
+// only goes back to the strings to load the next 8 bytes of the records whose
+// words tied. Buckets of 16 records or fewer are finished with an insertion
+// sort. The strings are then moved into place in one pass.
+//
+// In parallel mode partitions of more than 64k records are sorted on their
+// own thread, up to std::thread::hardware_concurrency() threads.
+enum sstring_sort_mode
+{
+    sstring_sequential,
+    sstring_parallel
+};
+
+namespace sstring_sort_detail
+{
+    // 8 bytes of a string at depth, read big endian so integer order is byte
+    // order. Bytes past the end of the string are zero
+    struct record
+    {
+        unsigned long long word;
+        SString::const_pointer data;
+        SString::size_type length;
+        SString::size_type index; // Position in the unsorted range
+    };
+
+    // Appends a record for each string in [first, last)
+    template <typename Iterator>
+    std::vector<record> records(Iterator first, Iterator last);
+
+    // Sorts records by their strings, ties are ordered by index when stable
+    void sort(std::vector<record>& records, bool stable, sstring_sort_mode mode);
+}
+
+template <typename RandomIt>
+void sstring_sort(RandomIt first, RandomIt last,
+                  sstring_sort_mode mode = sstring_sequential);
+
+// Equal strings keep their relative order
+template <typename RandomIt>
+void sstring_stable_sort(RandomIt first, RandomIt last,
+                         sstring_sort_mode mode = sstring_sequential);
+
+/*******
+Implementation Section for the sstring_sort templates.
+*******/
+
+namespace sstring_sort_detail
+{
+    template <typename Iterator>
+    std::vector<record> records(Iterator first, Iterator last)
+    {
+        std::vector<record> result;
+        result.reserve(std::distance(first, last));
+
+        for (SString::size_type i = 0; first != last; ++first, ++i)
+        {
+            record r = { 0, first->begin(), first->length(), i };
+            result.push_back(r);
+        }
+
+        return result;
+    }
+
+    template <typename RandomIt>
+    void sort(RandomIt first, RandomIt last, bool stable, sstring_sort_mode mode)
+    {
+        std::vector<record> sorted = records(first, last);
+        sort(sorted, stable, mode);
+
+        std::vector<SString> strings;
+        strings.reserve(sorted.size());
+        for (const record& r : sorted)
+        {
+            strings.push_back(std::move(first[r.index]));
+        }
+
+        std::move(strings.begin(), strings.end(), first);
+    }
+}
+
+template <typename RandomIt>
+void sstring_sort(RandomIt first, RandomIt last, sstring_sort_mode mode)
+{
+    sstring_sort_detail::sort(first, last, false, mode);
+}
+
+template <typename RandomIt>
+void sstring_stable_sort(RandomIt first, RandomIt last, sstring_sort_mode mode)
+{
+    sstring_sort_detail::sort(first, last, true, mode);
+}
+
+#endif // SSTRING_SORT_H
@@ -0,0 +1,220 @@
+/*
+File: sstring_stats.cpp
+
+Copyright (c) 2018 Alexander DuPree
+
+This software is released as open source through the MIT License
+
+Authors: Alexander DuPree
+
+https://github.com/AlexanderJDupree/Python-Strings-for-CPP
+
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <mutex>
+#include <vector>
+#include "sstring_stats.h"
+
+/****** THREAD LOCAL COUNTERS ******/
+
+// Mirrors SStringStats::counters. Only the owning thread writes, with relaxed
+// loads and stores that compile to plain increments, other threads read while
+// taking a snapshot
+struct local_counters
+{
+    std::atomic<long long> allocations;
+    std::atomic<long long> frees;
+    std::atomic<long long> live_buffers;
+    std::atomic<long long> live_bytes;
+    std::atomic<long long> shared_copies;
+    std::atomic<long long> deep_copies;
+    std::atomic<long long> length_histogram[SStringStats::buckets];
+    std::atomic<long long> ref_count_histogram[SStringStats::buckets];
+};
+
+// The counters of every live thread and the totals of exited threads. Leaked
+// so strings destroyed during static destruction can still be recorded
+struct stats_registry
+{
+    std::mutex lock;
+    std::vector<local_counters*> threads;
+    SStringStats::counters retired;
+};
+
+static stats_registry& registry()
+{
+    static stats_registry* instance = new stats_registry();
+    return *instance;
+}
+
+static void add(long long& total, const std::atomic<long long>& value)
+{
+    total += value.load(std::memory_order_relaxed);
+}
+
+static void accumulate(SStringStats::counters& total, const local_counters& c)
+{
+    add(total.allocations, c.allocations);
+    add(total.frees, c.frees);
+    add(total.live_buffers, c.live_buffers);
+    add(total.live_bytes, c.live_bytes);
+    add(total.shared_copies, c.shared_copies);
+    add(total.deep_copies, c.deep_copies);
+    for (unsigned i = 0; i < SStringStats::buckets; ++i)
+    {
+        add(total.length_histogram[i], c.length_histogram[i]);
+        add(total.ref_count_histogram[i], c.ref_count_histogram[i]);
+    }
+}
+
+// Registers the thread's counters on first use and retires them when the
+// thread exits
+struct thread_registration
+{
+    local_counters* counters;
+
+    thread_registration(local_counters* c) : counters(c)
+    {
+        std::lock_guard<std::mutex> guard(registry().lock);
+        registry().threads.push_back(counters);
+    }
+
+    ~thread_registration()
+    {
+        stats_registry& stats = registry();
+        std::lock_guard<std::mutex> guard(stats.lock);
+
+        accumulate(stats.retired, *counters);
+        stats.threads.erase(std::find(stats.threads.begin(),
+                                      stats.threads.end(), counters));
+    }
+};
+
+// Zero initialized without a guard, the registration is only touched once
+static thread_local local_counters thread_counters;
+static thread_local bool thread_registered;
+
+static local_counters& local()
+{
+    if (!thread_registered)
+    {
+        thread_registered = true;
+        static thread_local thread_registration registration(&thread_counters);
+    }
+
+    return thread_counters;
+}
+
+static void increment(std::atomic<long long>& counter, long long n = 1)
+{
+    counter.store(counter.load(std::memory_order_relaxed) + n,
+                  std::memory_order_relaxed);
+}
+
+/****** SNAPSHOTS ******/
+
+bool SStringStats::enabled()
+{
+#ifdef SSTRING_ENABLE_STATS
+    return true;
+#else
+    return false;
+#endif
+}
+
+SStringStats::counters SStringStats::snapshot()
+{
+    stats_registry& stats = registry();
+    std::lock_guard<std::mutex> guard(stats.lock);
+
+    counters total = stats.retired;
+    for (unsigned i = 0; i < stats.threads.size(); ++i)
+    {
+        accumulate(total, *stats.threads[i]);
+    }
+
+    return total;
+}
+
+static void dump_histogram(std::ostream& os, const long long* histogram)
+{
+    // Trailing empty buckets are omitted
+    unsigned last = SStringStats::buckets;
+    while (last > 0 && histogram[last - 1] == 0)
+    {
+        --last;
+    }
+
+    os << '[';
+    for (unsigned i = 0; i < last; ++i)
+    {
+        os << (i ? "," : "") << histogram[i];
+    }
+    os << ']';
+}
+
+void SStringStats::dump(std::ostream& os)
+{
+    dump(os, snapshot());
+}
+
+void SStringStats::dump(std::ostream& os, const counters& stats)
+{
+    os << "{\"enabled\":" << (enabled() ? "true" : "false")
+       << ",\"allocations\":" << stats.allocations
+       << ",\"frees\":" << stats.frees
+       << ",\"live_buffers\":" << stats.live_buffers
+       << ",\"live_bytes\":" << stats.live_bytes
+       << ",\"shared_copies\":" << stats.shared_copies
+       << ",\"deep_copies\":" << stats.deep_copies
+       << ",\"length_histogram\":";
+    dump_histogram(os, stats.length_histogram);
+    os << ",\"ref_count_histogram\":";
+    dump_histogram(os, stats.ref_count_histogram);
+    os << '}';
+}
+
+/****** HOOKS ******/
+
+void SStringStats::record_allocation(std::size_t elements, std::size_t bytes)
+{
+    local_counters& c = local();
+    increment(c.allocations);
+    increment(c.live_buffers);
+    increment(c.live_bytes, bytes);
+    increment(c.length_histogram[bucket(elements)]);
+}
+
+void SStringStats::record_free(std::size_t bytes)
+{
+    local_counters& c = local();
+    increment(c.frees);
+    increment(c.live_buffers, -1);
+    increment(c.live_bytes, -(long long)bytes);
+}
+
+void SStringStats::record_shared_copy(unsigned ref_count)
+{
+    local_counters& c = local();
+    increment(c.shared_copies);
+    increment(c.ref_count_histogram[bucket(ref_count)]);
+}
+
+void SStringStats::record_deep_copy()
+{
+    increment(local().deep_copies);
+}
+
+unsigned SStringStats::bucket(unsigned long long value)
+{
+    unsigned width = 0;
+    for (; value; value >>= 1)
+    {
+        ++width;
+    }
+
+    return std::min(width, buckets - 1);
+}
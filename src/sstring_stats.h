@@ -0,0 +1,78 @@
+/*
+File: sstring_stats.h
+
+Copyright (c) 2018 Alexander DuPree
+
+This software is released as open source through the MIT License
+
+Authors: Alexander DuPree
+
+https://github.com/AlexanderJDupree/Python-Strings-for-CPP
+
+*/
+
+#ifndef SSTRING_STATS_H
+#define SSTRING_STATS_H
+
+#include <cstddef>
+#include <iostream>
+
+// SStringStats counts allocations and sharing inside reference_manager. The
+// counters are only recorded when the library is built with
+// SSTRING_ENABLE_STATS defined, otherwise every hook expands to nothing and
+// snapshot() reports zeros.
+//
+// Each thread records into its own counters, snapshot() sums the counters of
+// every live thread with those of threads that have exited.
+class SStringStats
+{
+  public:
+
+    // Histograms have one bucket per bit width, bucket 0 counts zeros and
+    // bucket i counts values in [2^(i-1), 2^i)
+    static const unsigned buckets = 33;
+
+    struct counters
+    {
+        long long allocations; // Buffers allocated
+        long long frees; // Buffers released
+        long long live_buffers; // Buffers currently allocated
+        long long live_bytes; // Bytes of data and control blocks allocated
+        long long shared_copies; // Copies that shared an existing buffer
+        long long deep_copies; // Strings built by copying existing characters
+        long long length_histogram[buckets]; // Elements per allocation
+        long long ref_count_histogram[buckets]; // Reference count after sharing
+    };
+
+    // Tests if the library was built with SSTRING_ENABLE_STATS
+    static bool enabled();
+
+    // Returns the counters summed across every thread
+    static counters snapshot();
+
+    // Writes the counters as a JSON object
+    static void dump(std::ostream& os);
+    static void dump(std::ostream& os, const counters& stats);
+
+    /****** HOOKS ******/
+
+    // Called through SSTRING_STATS() by reference_manager and SString
+
+    static void record_allocation(std::size_t elements, std::size_t bytes);
+    static void record_free(std::size_t bytes);
+    static void record_shared_copy(unsigned ref_count);
+    static void record_deep_copy();
+
+  private:
+
+    // Returns the histogram bucket of value
+    static unsigned bucket(unsigned long long value);
+};
+
+#ifdef SSTRING_ENABLE_STATS
+#define SSTRING_STATS(hook) SStringStats::hook
+#else
+#define SSTRING_STATS(hook) ((void)0)
+#endif
+
+#endif // SSTRING_STATS_H
@@ -0,0 +1,333 @@
+/*
+File: sstring_trace.cpp
+
+Copyright (c) 2018 Alexander DuPree
+
+This software is released as open source through the MIT License
+
+Authors: Alexander DuPree
+
+https://github.com/AlexanderJDupree/Python-Strings-for-CPP
+
+*/
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include "sstring_trace.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define SSTRING_TRACE_RDTSC
+#endif
+
+/****** HISTOGRAM ******/
+
+const unsigned SStringTrace::histogram::buckets;
+
+SStringTrace::histogram::histogram()
+    : _counts(), _total(0) {}
+
+void SStringTrace::histogram::add(tick_type value, unsigned long long count)
+{
+    _counts[bucket(value)] += count;
+    _total += count;
+}
+
+unsigned long long SStringTrace::histogram::count() const
+{
+    return _total;
+}
+
+unsigned long long SStringTrace::histogram::at(unsigned index) const
+{
+    return _counts[index];
+}
+
+SStringTrace::tick_type SStringTrace::histogram::percentile(double p) const
+{
+    if (_total == 0)
+    {
+        return 0;
+    }
+
+    // The rank of the percentile, at least the first value
+    unsigned long long rank = (unsigned long long)(p / 100 * _total + 0.5);
+    rank = rank ? rank : 1;
+
+    unsigned long long seen = 0;
+    for (unsigned i = 0; i < buckets; ++i)
+    {
+        seen += _counts[i];
+        if (seen >= rank)
+        {
+            return lower_bound(i);
+        }
+    }
+
+    return lower_bound(buckets - 1);
+}
+
+unsigned SStringTrace::histogram::bucket(tick_type value)
+{
+    if (value < 16)
+    {
+        return (unsigned)value;
+    }
+
+    unsigned msb = 63;
+    while (!(value >> msb))
+    {
+        --msb;
+    }
+
+    // The three bits below the most significant bit pick the sub-bucket
+    return 16 + (msb - 4) * 8 + ((value >> (msb - 3)) & 7);
+}
+
+SStringTrace::tick_type SStringTrace::histogram::lower_bound(unsigned index)
+{
+    if (index < 16)
+    {
+        return index;
+    }
+
+    unsigned msb = (index - 16) / 8 + 4;
+    return (tick_type)(8 + (index - 16) % 8) << (msb - 3);
+}
+
+/****** SHARED STATE ******/
+
+// Samples are rare, so every thread adds into the same relaxed counters
+static std::atomic<unsigned long long> 
+    trace_counts[SStringTrace::operation_count][SStringTrace::histogram::buckets];
+
+static std::atomic<unsigned> trace_rate(0);
+static std::atomic<SStringTrace::hook_type> trace_hook(nullptr);
+
+// Operations left on this thread before the next sample
+static thread_local unsigned countdown;
+
+// Start of a sampled constructor, see begin()
+static thread_local SStringTrace::tick_type pending;
+
+static const char* const operation_names[SStringTrace::operation_count] = {
+    "construct", "concatenate", "compare", "substring", "strip", "stream_io"
+};
+
+/****** CONFIGURATION ******/
+
+void SStringTrace::set_sample_rate(unsigned rate)
+{
+    trace_rate.store(rate, std::memory_order_relaxed);
+}
+
+unsigned SStringTrace::sample_rate()
+{
+    return trace_rate.load(std::memory_order_relaxed);
+}
+
+void SStringTrace::set_hook(hook_type hook)
+{
+    trace_hook.store(hook);
+}
+
+SStringTrace::histogram SStringTrace::snapshot(operation op)
+{
+    histogram result;
+    for (unsigned i = 0; i < histogram::buckets; ++i)
+    {
+        unsigned long long n = trace_counts[op][i].load(std::memory_order_relaxed);
+        if (n)
+        {
+            result.add(histogram::lower_bound(i), n);
+        }
+    }
+
+    return result;
+}
+
+void SStringTrace::reset()
+{
+    for (unsigned op = 0; op < operation_count; ++op)
+    {
+        for (unsigned i = 0; i < histogram::buckets; ++i)
+        {
+            trace_counts[op][i].store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+double SStringTrace::ns_per_tick()
+{
+#ifdef SSTRING_TRACE_RDTSC
+    // Calibrates the cycle counter against steady_clock once, over 10ms
+    static const double calibrated = []() {
+        typedef std::chrono::steady_clock clock;
+
+        clock::time_point begin = clock::now();
+        tick_type first = now();
+        while (clock::now() - begin < std::chrono::milliseconds(10));
+
+        std::chrono::duration<double, std::nano> elapsed = clock::now() - begin;
+        return elapsed.count() / (now() - first);
+    }();
+
+    return calibrated;
+#else
+    return std::chrono::duration<double, std::nano>(
+        std::chrono::steady_clock::duration(1)).count();
+#endif
+}
+
+const char* SStringTrace::name(operation op)
+{
+    return operation_names[op];
+}
+
+/****** REPORTS ******/
+
+void SStringTrace::dump(std::ostream& os)
+{
+    // One header line, then one "operation bucket count" line per bucket
+    os << "sstring-trace 1 " << ns_per_tick() << '\n';
+    for (unsigned op = 0; op < operation_count; ++op)
+    {
+        for (unsigned i = 0; i < histogram::buckets; ++i)
+        {
+            unsigned long long n = trace_counts[op][i].load(std::memory_order_relaxed);
+            if (n)
+            {
+                os << operation_names[op] << ' ' << i << ' ' << n << '\n';
+            }
+        }
+    }
+}
+
+bool SStringTrace::load(std::istream& is, histogram* histograms, 
+                        double& ns_per_tick)
+{
+    std::string magic;
+    unsigned version = 0;
+    if (!(is >> magic >> version >> ns_per_tick) || 
+        magic != "sstring-trace" || version != 1)
+    {
+        return false;
+    }
+
+    std::string op_name;
+    unsigned index = 0;
+    unsigned long long n = 0;
+    while (is >> op_name >> index >> n)
+    {
+        unsigned op = 0;
+        while (op < operation_count && op_name != operation_names[op])
+        {
+            ++op;
+        }
+        if (op == operation_count || index >= histogram::buckets)
+        {
+            return false;
+        }
+
+        histograms[op].add(histogram::lower_bound(index), n);
+    }
+
+    return is.eof();
+}
+
+void SStringTrace::report(std::ostream& os)
+{
+    histogram histograms[operation_count];
+    for (unsigned op = 0; op < operation_count; ++op)
+    {
+        histograms[op] = snapshot(static_cast<operation>(op));
+    }
+
+    report(os, histograms, ns_per_tick());
+}
+
+void SStringTrace::report(std::ostream& os, const histogram* histograms,
+                          double ns_per_tick)
+{
+    static const double percentiles[] = { 50, 90, 99, 99.9, 100 };
+
+    char line[128];
+    std::snprintf(line, sizeof(line), "%-12s %10s %9s %9s %9s %9s %9s\n",
+                  "operation", "samples", "p50 ns", "p90 ns", "p99 ns", 
+                  "p99.9 ns", "max ns");
+    os << line;
+
+    for (unsigned op = 0; op < operation_count; ++op)
+    {
+        const histogram& h = histograms[op];
+        int n = std::snprintf(line, sizeof(line), "%-12s %10llu",
+                              operation_names[op], h.count());
+        for (unsigned i = 0; i < 5; ++i)
+        {
+            n += std::snprintf(line + n, sizeof(line) - n, " %9.0f",
+                               h.percentile(percentiles[i]) * ns_per_tick);
+        }
+        os << line << '\n';
+    }
+}
+
+/****** HOOKS ******/
+
+void SStringTrace::begin()
+{
+    pending = start();
+}
+
+void SStringTrace::end(operation op)
+{
+    if (pending)
+    {
+        stop(op, pending);
+        pending = 0;
+    }
+}
+
+SStringTrace::tick_type SStringTrace::start()
+{
+    // The rate is read on every call so changes apply immediately, it is a
+    // relaxed load of a rarely written word
+    unsigned rate = trace_rate.load(std::memory_order_relaxed);
+    if (rate == 0)
+    {
+        return 0;
+    }
+
+    if (countdown > 1 && countdown <= rate)
+    {
+        --countdown;
+        return 0;
+    }
+
+    countdown = rate;
+    return now();
+}
+
+void SStringTrace::stop(operation op, tick_type start)
+{
+    tick_type ticks = now() - start;
+
+    trace_counts[op][histogram::bucket(ticks)].fetch_add(1, std::memory_order_relaxed);
+
+    hook_type hook = trace_hook.load(std::memory_order_relaxed);
+    if (hook)
+    {
+        hook(op, ticks);
+    }
+}
+
+SStringTrace::tick_type SStringTrace::now()
+{
+#ifdef SSTRING_TRACE_RDTSC
+    return __rdtsc();
+#else
+    return std::chrono::steady_clock::now().time_since_epoch().count();
+#endif
+}
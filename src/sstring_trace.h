@@ -0,0 +1,156 @@
+/*
+File: sstring_trace.h
+
+Copyright (c) 2018 Alexander DuPree
+
+This software is released as open source through the MIT License
+
+Authors: Alexander DuPree
+
+https://github.com/AlexanderJDupree/Python-Strings-for-CPP
+
+*/
+
+#ifndef SSTRING_TRACE_H
+#define SSTRING_TRACE_H
+
+#include <iostream>
+
+// SStringTrace samples the latency of SString operations into per-operation
+// log-linear histograms. Tracing is only compiled in when the library is built
+// with SSTRING_ENABLE_TRACE defined, otherwise every hook expands to nothing.
+//
+// Even when compiled in, nothing is timed until set_sample_rate() is given a
+// non-zero rate. One in every rate operations on each thread is timed with
+// the cycle counter (steady_clock on platforms without one). A sample costs
+// a few tens of nanoseconds, so a rate of 1024 amortizes it to well under a
+// percent of any operation, while operations that aren't sampled only pay a
+// call and a relaxed load. See benchmarks/trace_benchmark.
+class SStringTrace
+{
+  public:
+
+    typedef unsigned long long tick_type;
+
+    enum operation
+    {
+        construct,
+        concatenate,
+        compare,
+        substring,
+        strip,
+        stream_io,
+        operation_count
+    };
+
+    // Called with every sampled latency, in addition to the histograms
+    typedef void (*hook_type)(operation op, tick_type ticks);
+
+    // Log-linear histogram, values below 16 are counted exactly and every
+    // power of two above is split into 8 buckets, so any recorded value is
+    // within 12.5% of its bucket's lower bound
+    class histogram
+    {
+      public:
+
+        static const unsigned buckets = 16 + 60 * 8;
+
+        histogram();
+
+        // Adds count occurrences of value
+        void add(tick_type value, unsigned long long count = 1);
+
+        // Returns the number of recorded values
+        unsigned long long count() const;
+
+        // Returns the lower bound of the bucket holding the p-th percentile,
+        // p in [0, 100]
+        tick_type percentile(double p) const;
+
+        // Returns the number of values recorded in bucket
+        unsigned long long at(unsigned bucket) const;
+
+        // Returns the bucket of value and the smallest value of a bucket
+        static unsigned bucket(tick_type value);
+        static tick_type lower_bound(unsigned bucket);
+
+      private:
+
+        unsigned long long _counts[buckets];
+        unsigned long long _total;
+    };
+
+    // Records a sample every rate operations per thread, 0 stops sampling
+    static void set_sample_rate(unsigned rate);
+    static unsigned sample_rate();
+
+    // Installs a hook called with each sample, NULL removes it
+    static void set_hook(hook_type hook);
+
+    // Returns the samples recorded for op
+    static histogram snapshot(operation op);
+
+    // Clears every histogram
+    static void reset();
+
+    // Returns the duration of one tick in nanoseconds
+    static double ns_per_tick();
+
+    // Returns the name of op as used by dump() and report()
+    static const char* name(operation op);
+
+    // Writes every histogram in the text format read by load()
+    static void dump(std::ostream& os);
+
+    // Reads histograms written by dump(), returns false on malformed input
+    static bool load(std::istream& is, histogram* histograms, double& ns_per_tick);
+
+    // Writes a table of count and latency percentiles per operation
+    static void report(std::ostream& os);
+    static void report(std::ostream& os, const histogram* histograms,
+                       double ns_per_tick);
+
+    /****** HOOKS ******/
+
+    // Times its own lifetime, used through SSTRING_TRACE()
+    class scope
+    {
+      public:
+        explicit scope(operation op) : _op(op), _start(start()) {}
+        ~scope() { if (_start) stop(_op, _start); }
+
+      private:
+        operation _op;
+        tick_type _start;
+
+        scope(const scope&);
+        scope& operator=(const scope&);
+    };
+
+    // Constructors allocate before their body runs, so they begin timing from
+    // their initializer list through SSTRING_TRACE_BEGIN() and stop at the end
+    // of their body with SSTRING_TRACE_END()
+    static void begin();
+    static void end(operation op);
+
+    // Returns the current tick if this operation is sampled, otherwise 0
+    static tick_type start();
+
+    // Records the latency of a sampled operation
+    static void stop(operation op, tick_type start);
+
+    // Returns the current value of the cycle counter or steady_clock
+    static tick_type now();
+};
+
+#ifdef SSTRING_ENABLE_TRACE
+#define SSTRING_TRACE(op) SStringTrace::scope sstring_trace_scope(SStringTrace::op)
+#define SSTRING_TRACE_BEGIN() SStringTrace::begin()
+#define SSTRING_TRACE_END(op) SStringTrace::end(SStringTrace::op)
+#else
+#define SSTRING_TRACE(op) ((void)0)
+#define SSTRING_TRACE_BEGIN() ((void)0)
+#define SSTRING_TRACE_END(op) ((void)0)
+#endif
+
+#endif // SSTRING_TRACE_H
@@ -0,0 +1,369 @@
+/*
+File: sstring_translate.cpp
+
+Copyright (c) 2018 Alexander DuPree
+
+This software is released as open source through the MIT License
+
+Authors: Alexander DuPree
+
+https://github.com/AlexanderJDupree/Python-Strings-for-CPP
+
+Description: SString::maketrans and SString::translate, with SSSE3 kernels
+             selected at runtime on x86
+
+*/
+
+#include <cstring>
+#include "sstring.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SSTRING_TRANSLATE_SSSE3
+#include <tmmintrin.h>
+#endif
+
+/****** TRANSLATION TABLES ******/
+
+SString::translation::translation() : _rows(0), _removing(false)
+{
+    for (unsigned c = 0; c < 256; ++c)
+    {
+        _map[c] = c;
+    }
+
+    std::memset(_removed, 0, sizeof(_removed));
+}
+
+void SString::translation::set(char from, char to)
+{
+    unsigned char b = from;
+    _map[b] = to;
+    _rows |= 1u << (b >> 4);
+}
+
+void SString::translation::remove(char c)
+{
+    unsigned char b = c;
+    _removed[(b & 15) | (b >> 7 << 4)] |= 1u << ((b >> 4) & 7);
+    _removing = true;
+}
+
+SString::translation 
+SString::maketrans(const_pointer from, const_pointer to, const_pointer remove)
+{
+    size_type n = len(from);
+    if (n != len(to))
+    {
+        throw std::invalid_argument("maketrans arguments must have equal length");
+    }
+
+    translation table;
+    for (size_type i = 0; i < n; ++i)
+    {
+        table.set(from[i], to[i]);
+    }
+    for (size_type i = 0; i < len(remove); ++i)
+    {
+        table.remove(remove[i]);
+    }
+
+    return table;
+}
+
+/****** SCALAR KERNELS ******/
+
+static SString::size_type count_removed(const SString::translation& table,
+                                        const char* in, SString::size_type n)
+{
+    SString::size_type removed = 0;
+    for (SString::size_type i = 0; i < n; ++i)
+    {
+        removed += table.removes(in[i]);
+    }
+
+    return removed;
+}
+
+static void translate_bytes(const SString::translation& table, const char* in,
+                            SString::size_type n, char* out)
+{
+    for (SString::size_type i = 0; i < n; ++i)
+    {
+        out[i] = table[in[i]];
+    }
+}
+
+// Writes every byte but only advances past kept ones, the caller rewrites
+// the terminator
+static void translate_removing(const SString::translation& table, 
+                               const char* in, SString::size_type n, char* out)
+{
+    for (SString::size_type i = 0; i < n; ++i)
+    {
+        *out = table[in[i]];
+        out += !table.removes(in[i]);
+    }
+}
+
+/****** SSSE3 KERNELS ******/
+
+#ifdef SSTRING_TRANSLATE_SSSE3
+
+// A 256-byte table is 16 rows of 16 bytes, one per high nibble. pshufb looks
+// up a whole row by low nibble for 16 bytes at once, so each byte is mapped
+// by shuffling every row holding a changed byte and keeping the result in
+// the lanes whose high nibble selects that row. Bytes in unchanged rows
+// pass through. Past max_rows the scalar lookup is faster
+static const unsigned max_rows = 8;
+
+static bool has_ssse3()
+{
+    static const bool supported = __builtin_cpu_supports("ssse3");
+    return supported;
+}
+
+// The mapped rows of a table, loaded once per call
+struct shuffle_rows
+{
+    __m128i tables[16];
+    __m128i nibbles[16];
+    unsigned count;
+};
+
+__attribute__((target("ssse3")))
+static void load_rows(const unsigned char* map, unsigned rows, 
+                      shuffle_rows& loaded)
+{
+    loaded.count = 0;
+    for (; rows; rows &= rows - 1)
+    {
+        int row = __builtin_ctz(rows);
+        loaded.tables[loaded.count] = 
+            _mm_loadu_si128((const __m128i*)(map + 16 * row));
+        loaded.nibbles[loaded.count] = _mm_set1_epi8(row);
+        ++loaded.count;
+    }
+}
+
+__attribute__((target("ssse3")))
+static inline __m128i map_block(const shuffle_rows& rows, __m128i v)
+{
+    const __m128i low_mask = _mm_set1_epi8(0x0f);
+    __m128i low = _mm_and_si128(v, low_mask);
+    __m128i high = _mm_and_si128(_mm_srli_epi16(v, 4), low_mask);
+
+    for (unsigned r = 0; r < rows.count; ++r)
+    {
+        __m128i in_row = _mm_cmpeq_epi8(high, rows.nibbles[r]);
+        __m128i mapped = _mm_shuffle_epi8(rows.tables[r], low);
+        v = _mm_or_si128(_mm_andnot_si128(in_row, v), 
+                         _mm_and_si128(in_row, mapped));
+    }
+
+    return v;
+}
+
+// Looks up the removed set by nibbles, returns a mask with bit i set when
+// byte i of v is kept
+__attribute__((target("ssse3")))
+static inline unsigned kept_block(const unsigned char* removed, __m128i v)
+{
+    const __m128i low_mask = _mm_set1_epi8(0x0f);
+    const __m128i low_bits = _mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128,
+                                           0, 0, 0, 0, 0, 0, 0, 0);
+    const __m128i high_bits = _mm_setr_epi8(0, 0, 0, 0, 0, 0, 0, 0,
+                                            1, 2, 4, 8, 16, 32, 64, -128);
+
+    __m128i low = _mm_and_si128(v, low_mask);
+    __m128i high = _mm_and_si128(_mm_srli_epi16(v, 4), low_mask);
+
+    __m128i first = _mm_and_si128(
+        _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)removed), low),
+        _mm_shuffle_epi8(low_bits, high));
+    __m128i second = _mm_and_si128(
+        _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(removed + 16)), low),
+        _mm_shuffle_epi8(high_bits, high));
+
+    __m128i kept = _mm_cmpeq_epi8(_mm_or_si128(first, second), 
+                                  _mm_setzero_si128());
+    return _mm_movemask_epi8(kept);
+}
+
+__attribute__((target("ssse3")))
+static SString::size_type count_removed_ssse3(const unsigned char* removed,
+                                              const char* in, 
+                                              SString::size_type n)
+{
+    SString::size_type kept = 0;
+    SString::size_type i = 0;
+    for (; i + 16 <= n; i += 16)
+    {
+        __m128i v = _mm_loadu_si128((const __m128i*)(in + i));
+        kept += __builtin_popcount(kept_block(removed, v));
+    }
+
+    return i - kept;
+}
+
+__attribute__((target("ssse3")))
+static void translate_bytes_ssse3(const unsigned char* map, unsigned rows,
+                                  const char* in, SString::size_type n, 
+                                  char* out)
+{
+    shuffle_rows loaded;
+    load_rows(map, rows, loaded);
+
+    SString::size_type i = 0;
+    for (; i + 16 <= n; i += 16)
+    {
+        __m128i v = _mm_loadu_si128((const __m128i*)(in + i));
+        _mm_storeu_si128((__m128i*)(out + i), map_block(loaded, v));
+    }
+}
+
+// Shuffle masks packing the bytes selected by an 8-bit mask to the front
+struct compaction_table
+{
+    unsigned char shuffles[256][8];
+
+    compaction_table()
+    {
+        for (unsigned mask = 0; mask < 256; ++mask)
+        {
+            unsigned n = 0;
+            for (unsigned bit = 0; bit < 8; ++bit)
+            {
+                if (mask & (1u << bit))
+                {
+                    shuffles[mask][n++] = bit;
+                }
+            }
+            while (n < 8)
+            {
+                shuffles[mask][n++] = 0x80;
+            }
+        }
+    }
+};
+
+// Each half of a block is packed by one shuffle and stored with an 8-byte
+// write, which may run past the kept bytes. Near the end of out, where that
+// would overflow, bytes are copied one at a time
+__attribute__((target("ssse3")))
+static SString::size_type translate_removing_ssse3(const unsigned char* map, 
+                                                   unsigned rows,
+                                                   const unsigned char* removed,
+                                                   const char* in, 
+                                                   SString::size_type n, 
+                                                   char* out, char* out_end)
+{
+    static const compaction_table compaction;
+
+    shuffle_rows loaded;
+    load_rows(map, rows, loaded);
+
+    const __m128i high_half = _mm_set1_epi8(8);
+    char* start = out;
+    SString::size_type i = 0;
+    for (; i + 16 <= n; i += 16)
+    {
+        __m128i v = _mm_loadu_si128((const __m128i*)(in + i));
+        unsigned kept = kept_block(removed, v);
+        v = map_block(loaded, v);
+
+        if (out_end - out >= 16)
+        {
+            __m128i low = _mm_loadl_epi64(
+                (const __m128i*)compaction.shuffles[kept & 0xff]);
+            __m128i high = _mm_add_epi8(high_half, _mm_loadl_epi64(
+                (const __m128i*)compaction.shuffles[kept >> 8]));
+
+            _mm_storel_epi64((__m128i*)out, _mm_shuffle_epi8(v, low));
+            out += __builtin_popcount(kept & 0xff);
+            _mm_storel_epi64((__m128i*)out, _mm_shuffle_epi8(v, high));
+            out += __builtin_popcount(kept >> 8);
+            continue;
+        }
+
+        char block[16];
+        _mm_storeu_si128((__m128i*)block, v);
+        for (; kept; kept &= kept - 1)
+        {
+            *out++ = block[__builtin_ctz(kept)];
+        }
+    }
+
+    return out - start;
+}
+
+#endif // SSTRING_TRANSLATE_SSSE3
+
+/****** TRANSLATION ******/
+
+SString SString::translate(const translation& table) const
+{
+    if (table._rows == 0 && !table._removing)
+    {
+        return *this;
+    }
+
+    // The vector kernels handle whole blocks of 16 characters, the scalar
+    // loops finish the rest
+    size_type blocks = 0;
+    bool shuffle = false;
+    size_type removed = 0;
+
+#ifdef SSTRING_TRANSLATE_SSSE3
+    if (has_ssse3())
+    {
+        blocks = _length / 16 * 16;
+        shuffle = __builtin_popcount(table._rows) <= (int)max_rows;
+        if (table._removing)
+        {
+            removed = count_removed_ssse3(table._removed, _str, blocks);
+        }
+    }
+#endif
+
+    if (table._removing)
+    {
+        removed += count_removed(table, _str + blocks, _length - blocks);
+    }
+    if (removed == 0 && table._rows == 0)
+    {
+        return *this;
+    }
+
+    SString result(uninitialized_tag(), _length - removed);
+    char* out = result._data;
+    size_type done = 0;
+
+#ifdef SSTRING_TRANSLATE_SSSE3
+    if (shuffle && removed)
+    {
+        out += translate_removing_ssse3(table._map, table._rows, table._removed,
+                                        _str, blocks, out, out + result._length);
+        done = blocks;
+    }
+    else if (shuffle)
+    {
+        translate_bytes_ssse3(table._map, table._rows, _str, blocks, out);
+        out += blocks;
+        done = blocks;
+    }
+#else
+    (void)shuffle;
+#endif
+
+    if (removed)
+    {
+        translate_removing(table, _str + done, _length - done, out);
+        result._data[result._length] = '\0';
+    }
+    else
+    {
+        translate_bytes(table, _str + done, _length - done, out);
+    }
+
+    return result;
+}
@@ -0,0 +1,546 @@
+/*
+File: sstring_unicode.cpp
+
+Copyright (c) 2018 Alexander DuPree
+
+This software is released as open source through the MIT License
+
+Authors: Alexander DuPree
+
+https://github.com/AlexanderJDupree/Python-Strings-for-CPP
+
+Description: SString::validate_utf8, from_latin1 and the UTF-16 transcoders.
+             Each sizes its output in a first pass so the result is allocated
+             once. UTF-8 is validated 16 bytes at a time with SSSE3, selected
+             at runtime on x86, and ASCII runs are copied 8 or 16 characters
+             at a time with SSE2
+
+*/
+
+#include "sstring.h"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SSTRING_UNICODE_SSSE3
+#include <tmmintrin.h>
+#endif
+
+typedef SString::size_type size_type;
+
+// Decoded in place of an invalid sequence or unpaired surrogate
+static const unsigned invalid = 0x110000;
+
+static const unsigned replacement = 0xfffd;
+
+/****** SCALAR KERNELS ******/
+
+// Decodes the UTF-8 sequence at in into code_point, which is invalid if the
+// sequence is. Returns the sequence's length, for an invalid sequence the
+// length of its longest valid prefix and at least 1, so that each maximal
+// invalid subsequence is replaced once as python does
+static inline size_type decode_sequence(const unsigned char* in,
+                                        const unsigned char* end,
+                                        unsigned& code_point)
+{
+    unsigned char lead = in[0];
+    if (lead < 0x80)
+    {
+        code_point = lead;
+        return 1;
+    }
+    if (lead < 0xc2 || lead > 0xf4)
+    {
+        code_point = invalid;
+        return 1;
+    }
+
+    // The second byte's range excludes overlong forms, surrogates and code
+    // points past U+10FFFF
+    size_type n = lead < 0xe0 ? 2 : lead < 0xf0 ? 3 : 4;
+    unsigned char low = lead == 0xe0 ? 0xa0 : lead == 0xf0 ? 0x90 : 0x80;
+    unsigned char high = lead == 0xed ? 0x9f : lead == 0xf4 ? 0x8f : 0xbf;
+
+    code_point = lead & (0x7f >> n);
+    for (size_type i = 1; i < n; ++i)
+    {
+        if (in + i == end || in[i] < low || in[i] > high)
+        {
+            code_point = invalid;
+            return i;
+        }
+        code_point = code_point << 6 | (in[i] & 0x3f);
+        low = 0x80;
+        high = 0xbf;
+    }
+
+    return n;
+}
+
+// Decodes the unit or surrogate pair at in[i], advancing i past it
+static inline unsigned decode_unit(const char16_t* in, size_type n, size_type& i)
+{
+    unsigned unit = in[i++];
+    if ((unit & 0xf800) != 0xd800)
+    {
+        return unit;
+    }
+    if (unit < 0xdc00 && i < n && (in[i] & 0xfc00) == 0xdc00)
+    {
+        return 0x10000 + ((unit - 0xd800) << 10 | (in[i++] - 0xdc00));
+    }
+
+    return invalid;
+}
+
+static inline size_type utf8_size(unsigned code_point)
+{
+    return 1 + (code_point >= 0x80) + (code_point >= 0x800) +
+           (code_point >= 0x10000);
+}
+
+static inline unsigned char* encode_sequence(unsigned code_point,
+                                             unsigned char* out)
+{
+    if (code_point < 0x80)
+    {
+        *out++ = code_point;
+    }
+    else if (code_point < 0x800)
+    {
+        *out++ = 0xc0 | code_point >> 6;
+        *out++ = 0x80 | (code_point & 0x3f);
+    }
+    else if (code_point < 0x10000)
+    {
+        *out++ = 0xe0 | code_point >> 12;
+        *out++ = 0x80 | ((code_point >> 6) & 0x3f);
+        *out++ = 0x80 | (code_point & 0x3f);
+    }
+    else
+    {
+        *out++ = 0xf0 | code_point >> 18;
+        *out++ = 0x80 | ((code_point >> 12) & 0x3f);
+        *out++ = 0x80 | ((code_point >> 6) & 0x3f);
+        *out++ = 0x80 | (code_point & 0x3f);
+    }
+
+    return out;
+}
+
+static inline char16_t* encode_units(unsigned code_point, char16_t* out)
+{
+    if (code_point < 0x10000)
+    {
+        *out++ = code_point;
+    }
+    else
+    {
+        code_point -= 0x10000;
+        *out++ = 0xd800 | code_point >> 10;
+        *out++ = 0xdc00 | (code_point & 0x3ff);
+    }
+
+    return out;
+}
+
+static bool valid_utf8(const unsigned char* in, size_type n)
+{
+    const unsigned char* end = in + n;
+    while (in != end)
+    {
+        // Skips 8 ASCII characters at a time
+        uint64_t word;
+        if (end - in >= 8 && (std::memcpy(&word, in, 8),
+                              (word & 0x8080808080808080ull) == 0))
+        {
+            in += 8;
+            continue;
+        }
+
+        unsigned code_point;
+        in += decode_sequence(in, end, code_point);
+        if (code_point == invalid)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/****** SSSE3 KERNELS ******/
+
+#ifdef SSTRING_UNICODE_SSSE3
+
+static bool has_ssse3()
+{
+    static const bool supported = __builtin_cpu_supports("ssse3");
+    return supported;
+}
+
+__attribute__((target("ssse3")))
+static inline __m128i high_nibbles(__m128i v)
+{
+    return _mm_and_si128(_mm_srli_epi16(v, 4), _mm_set1_epi8(0x0f));
+}
+
+// Returns a nonzero lane for each byte of block that breaks UTF-8, given the
+// block before it. Each byte pair is classified by three shuffles, on the
+// high and low nibble of the first byte and the high nibble of the second,
+// into bits that are set in all three only for a bad pair. The bits are
+//   0x01 a lead not followed by a continuation
+//   0x02 a continuation following ASCII
+//   0x04 an overlong 3-byte form        0x08 a code point past U+10FFFF
+//   0x10 a surrogate                    0x20 an overlong 2-byte form
+//   0x40 an overlong 4-byte form or a code point past U+10FFFF
+//   0x80 two continuations in a row
+// The last bit is flipped for continuations that are the third or fourth
+// byte of a sequence, which may follow another continuation but must exist.
+// This is the lookup algorithm of Keiser and Lemire's simdutf
+__attribute__((target("ssse3")))
+static inline __m128i utf8_errors(__m128i block, __m128i previous)
+{
+    const __m128i first_high = _mm_setr_epi8(
+        0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02,
+        (char)0x80, (char)0x80, (char)0x80, (char)0x80, 0x21, 0x01, 0x15, 0x49);
+    const __m128i first_low = _mm_setr_epi8(
+        (char)0xe7, (char)0xa3, (char)0x83, (char)0x83, (char)0x8b, (char)0xcb,
+        (char)0xcb, (char)0xcb, (char)0xcb, (char)0xcb, (char)0xcb, (char)0xcb,
+        (char)0xcb, (char)0xdb, (char)0xcb, (char)0xcb);
+    const __m128i second_high = _mm_setr_epi8(
+        0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+        (char)0xe6, (char)0xae, (char)0xba, (char)0xba, 0x01, 0x01, 0x01, 0x01);
+
+    __m128i first = _mm_alignr_epi8(block, previous, 15);
+    __m128i pairs = _mm_and_si128(
+        _mm_and_si128(_mm_shuffle_epi8(first_high, high_nibbles(first)),
+                      _mm_shuffle_epi8(first_low,
+                                       _mm_and_si128(first, _mm_set1_epi8(0x0f)))),
+        _mm_shuffle_epi8(second_high, high_nibbles(block)));
+
+    // Bytes two after a 3 or 4-byte lead, or three after a 4-byte lead, get
+    // their top bit set by the saturating subtractions
+    __m128i third = _mm_subs_epu8(_mm_alignr_epi8(block, previous, 14),
+                                  _mm_set1_epi8(0xe0 - 0x80));
+    __m128i fourth = _mm_subs_epu8(_mm_alignr_epi8(block, previous, 13),
+                                   _mm_set1_epi8(0xf0 - 0x80));
+    __m128i continued = _mm_and_si128(_mm_or_si128(third, fourth),
+                                      _mm_set1_epi8((char)0x80));
+
+    return _mm_xor_si128(pairs, continued);
+}
+
+// Returns a nonzero lane for each lead at the end of block that its sequence
+// doesn't fit after
+__attribute__((target("ssse3")))
+static inline __m128i utf8_incomplete(__m128i block)
+{
+    const __m128i limits = _mm_setr_epi8(
+        -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+        (char)(0xf0 - 1), (char)(0xe0 - 1), (char)(0xc0 - 1));
+    return _mm_subs_epu8(block, limits);
+}
+
+__attribute__((target("ssse3")))
+static bool valid_utf8_ssse3(const unsigned char* in, size_type n)
+{
+    __m128i errors = _mm_setzero_si128();
+    __m128i previous = _mm_setzero_si128();
+    __m128i incomplete = _mm_setzero_si128();
+
+    // The final partial block is checked zero padded, and a sequence cut
+    // short by the end of the string is caught as incomplete
+    unsigned char tail[16] = { 0 };
+    for (size_type i = 0; i < n; i += 16)
+    {
+        __m128i block;
+        if (n - i >= 16)
+        {
+            block = _mm_loadu_si128((const __m128i*)(in + i));
+        }
+        else
+        {
+            std::memcpy(tail, in + i, n - i);
+            block = _mm_loadu_si128((const __m128i*)tail);
+        }
+
+        // An ASCII block only needs the block before it to be complete
+        if (_mm_movemask_epi8(block) == 0)
+        {
+            errors = _mm_or_si128(errors, incomplete);
+            incomplete = _mm_setzero_si128();
+        }
+        else
+        {
+            errors = _mm_or_si128(errors, utf8_errors(block, previous));
+            incomplete = utf8_incomplete(block);
+        }
+        previous = block;
+    }
+
+    errors = _mm_or_si128(errors, incomplete);
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(errors, _mm_setzero_si128())) == 0xffff;
+}
+
+#endif // SSTRING_UNICODE_SSSE3
+
+/****** UTF-8 ******/
+
+bool SString::validate_utf8() const
+{
+    const unsigned char* in = (const unsigned char*)_str;
+
+#ifdef SSTRING_UNICODE_SSSE3
+    if (has_ssse3())
+    {
+        return valid_utf8_ssse3(in, _length);
+    }
+#endif
+
+    return valid_utf8(in, _length);
+}
+
+/****** LATIN-1 ******/
+
+SString SString::from_latin1(const SString& bytes)
+{
+    const unsigned char* in = (const unsigned char*)bytes._str;
+    size_type n = bytes._length;
+
+    // Bytes past 0x7f take two characters
+    size_type length = n;
+    size_type i = 0;
+#ifdef __SSE2__
+    for (; i + 16 <= n; i += 16)
+    {
+        __m128i block = _mm_loadu_si128((const __m128i*)(in + i));
+        length += __builtin_popcount(_mm_movemask_epi8(block));
+    }
+#endif
+    for (; i < n; ++i)
+    {
+        length += in[i] >> 7;
+    }
+
+    if (length == n)
+    {
+        return bytes;
+    }
+
+    SString result(uninitialized_tag(), length);
+    unsigned char* out = (unsigned char*)result._data;
+
+    i = 0;
+    while (i < n)
+    {
+        size_type stop = n;
+#ifdef __SSE2__
+        if (n - i >= 16)
+        {
+            __m128i block = _mm_loadu_si128((const __m128i*)(in + i));
+            if (_mm_movemask_epi8(block) == 0)
+            {
+                _mm_storeu_si128((__m128i*)out, block);
+                out += 16;
+                i += 16;
+                continue;
+            }
+            stop = i + 16;
+        }
+#endif
+        for (; i < stop; ++i)
+        {
+            out = encode_sequence(in[i], out);
+        }
+    }
+
+    return result;
+}
+
+/****** UTF-16 ******/
+
+// Returns the UTF-8 length of n UTF-16 units, or npos for an unpaired
+// surrogate when strict. Replaced surrogates take U+FFFD's 3 bytes
+static size_type utf8_length(const char16_t* in, size_type n, bool strict)
+{
+    size_type length = 0;
+    size_type i = 0;
+    while (i < n)
+    {
+        size_type stop = n;
+#ifdef __SSE2__
+        // Units without surrogates take 1, 2 or 3 bytes. Saturating
+        // subtraction leaves units at or past a bound nonzero
+        if (n - i >= 8)
+        {
+            __m128i block = _mm_loadu_si128((const __m128i*)(in + i));
+            __m128i surrogates = _mm_cmpeq_epi16(
+                _mm_and_si128(block, _mm_set1_epi16((short)0xf800)),
+                _mm_set1_epi16((short)0xd800));
+            if (_mm_movemask_epi8(surrogates) == 0)
+            {
+                __m128i zero = _mm_setzero_si128();
+                unsigned one = _mm_movemask_epi8(_mm_cmpeq_epi16(
+                    _mm_subs_epu16(block, _mm_set1_epi16(0x7f)), zero));
+                unsigned two = _mm_movemask_epi8(_mm_cmpeq_epi16(
+                    _mm_subs_epu16(block, _mm_set1_epi16(0x7ff)), zero));
+
+                // Each unit has two mask bits
+                length += 24 - (__builtin_popcount(one) +
+                                __builtin_popcount(two)) / 2;
+                i += 8;
+                continue;
+            }
+            stop = i + 8;
+        }
+#endif
+        while (i < stop)
+        {
+            unsigned code_point = decode_unit(in, n, i);
+            if (code_point == invalid && strict)
+            {
+                return SString::npos;
+            }
+            length += code_point == invalid ? 3 : utf8_size(code_point);
+        }
+    }
+
+    return length;
+}
+
+bool SString::decode_utf16(const char16_t* units, size_type n, SString& str,
+                           unicode_errors errors)
+{
+    size_type length = utf8_length(units, n, errors == unicode_errors::strict);
+    if (length == npos)
+    {
+        return false;
+    }
+
+    SString result(uninitialized_tag(), length);
+    unsigned char* out = (unsigned char*)result._data;
+
+    size_type i = 0;
+    while (i < n)
+    {
+        size_type stop = n;
+#ifdef __SSE2__
+        if (n - i >= 8)
+        {
+            __m128i block = _mm_loadu_si128((const __m128i*)(units + i));
+            __m128i ascii = _mm_cmpeq_epi16(
+                _mm_subs_epu16(block, _mm_set1_epi16(0x7f)), _mm_setzero_si128());
+            if (_mm_movemask_epi8(ascii) == 0xffff)
+            {
+                _mm_storel_epi64((__m128i*)out, _mm_packus_epi16(block, block));
+                out += 8;
+                i += 8;
+                continue;
+            }
+            stop = i + 8;
+        }
+#endif
+        while (i < stop)
+        {
+            unsigned code_point = decode_unit(units, n, i);
+            out = encode_sequence(code_point == invalid ? replacement : code_point,
+                                  out);
+        }
+    }
+
+    swap(str, result);
+    return true;
+}
+
+// Returns the UTF-16 length of n characters of UTF-8. Valid UTF-8 takes a
+// unit for each byte that isn't a continuation and another for each 4-byte
+// lead, otherwise each replaced sequence takes one unit
+static size_type utf16_length(const unsigned char* in, size_type n, bool valid)
+{
+    const unsigned char* end = in + n;
+    if (!valid)
+    {
+        size_type length = 0;
+        while (in != end)
+        {
+            unsigned code_point;
+            in += decode_sequence(in, end, code_point);
+            length += 1 + (code_point != invalid && code_point >= 0x10000);
+        }
+        return length;
+    }
+
+    size_type length = 0;
+    size_type i = 0;
+#ifdef __SSE2__
+    for (; i + 16 <= n; i += 16)
+    {
+        __m128i block = _mm_loadu_si128((const __m128i*)(in + i));
+
+        // Continuations are the signed bytes below -64, 4-byte leads the
+        // bytes past 0xef
+        unsigned continuations = _mm_movemask_epi8(
+            _mm_cmplt_epi8(block, _mm_set1_epi8(-64)));
+        unsigned shorter = _mm_movemask_epi8(_mm_cmpeq_epi8(
+            _mm_subs_epu8(block, _mm_set1_epi8((char)0xef)), _mm_setzero_si128()));
+
+        length += 32 - __builtin_popcount(continuations) -
+                  __builtin_popcount(shorter);
+    }
+#endif
+    for (; i < n; ++i)
+    {
+        length += ((in[i] & 0xc0) != 0x80) + (in[i] >= 0xf0);
+    }
+
+    return length;
+}
+
+bool SString::encode_utf16(std::u16string& units, unicode_errors errors) const
+{
+    const unsigned char* in = (const unsigned char*)_str;
+    const unsigned char* end = in + _length;
+
+    bool valid = validate_utf8();
+    if (!valid && errors == unicode_errors::strict)
+    {
+        return false;
+    }
+
+    std::u16string result(utf16_length(in, _length, valid), u'\0');
+    char16_t* out = &result[0];
+
+    while (in != end)
+    {
+        const unsigned char* stop = end;
+#ifdef __SSE2__
+        if (end - in >= 16)
+        {
+            __m128i block = _mm_loadu_si128((const __m128i*)in);
+            if (_mm_movemask_epi8(block) == 0)
+            {
+                __m128i zero = _mm_setzero_si128();
+                _mm_storeu_si128((__m128i*)out, _mm_unpacklo_epi8(block, zero));
+                _mm_storeu_si128((__m128i*)(out + 8), _mm_unpackhi_epi8(block, zero));
+                out += 16;
+                in += 16;
+                continue;
+            }
+            stop = in + 16;
+        }
+#endif
+        while (in < stop)
+        {
+            unsigned code_point;
+            in += decode_sequence(in, end, code_point);
+            out = encode_units(code_point == invalid ? replacement : code_point,
+                               out);
+        }
+    }
+
+    units.swap(result);
+    return true;
+}
@@ -0,0 +1,137 @@
+/*
+File: sstring_writer.cpp
+
+Copyright (c) 2018 Alexander DuPree
+
+This software is released as open source through the MIT License
+
+Authors: Alexander DuPree
+
+https://github.com/AlexanderJDupree/Python-Strings-for-CPP
+
+*/
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <stdexcept>
+#include <system_error>
+#include <poll.h>
+#include <unistd.h>
+#include "sstring_writer.h"
+
+// The most iovecs one writev accepts
+#ifdef IOV_MAX
+static const std::ptrdiff_t max_iovecs = IOV_MAX;
+#else
+static const std::ptrdiff_t max_iovecs = 1024;
+#endif
+
+/****** CONSTRUCTORS ******/
+
+SStringWriter::SStringWriter(int fd, size_type batch_size)
+    : _fd(fd), _batch_size(batch_size)
+{
+    if (batch_size == 0)
+    {
+        throw std::invalid_argument("batch size must be positive");
+    }
+
+    _batch.reserve(std::min<size_type>(batch_size, max_iovecs));
+    _strings.reserve(std::min<size_type>(batch_size, max_iovecs));
+}
+
+SStringWriter::~SStringWriter()
+{
+    try
+    {
+        flush();
+    }
+    catch (const std::system_error&) {}
+}
+
+/****** WRITING ******/
+
+SStringWriter& SStringWriter::write(const SString& str)
+{
+    if (str.empty())
+    {
+        return *this;
+    }
+
+    iovec chars = { const_cast<char*>(str.begin()), str.length() };
+    _batch.push_back(chars);
+
+    // Literals need no reference, and one reference keeps every slice of a
+    // buffer gathered in a row alive
+    if (!str.is_immortal() &&
+        (_strings.empty() || _strings.back()._block != str._block))
+    {
+        _strings.push_back(str);
+    }
+
+    if (_batch.size() >= _batch_size)
+    {
+        flush();
+    }
+    return *this;
+}
+
+SStringWriter& SStringWriter::operator<<(const SString& str)
+{
+    return write(str);
+}
+
+void SStringWriter::flush()
+{
+    iovec* it = _batch.data();
+    iovec* end = it + _batch.size();
+    int error = 0;
+
+    while (it != end && error == 0)
+    {
+        ssize_t n = ::writev(_fd, it, std::min(end - it, max_iovecs));
+        if (n < 0)
+        {
+            pollfd writable = { _fd, POLLOUT, 0 };
+            if (errno == EAGAIN || errno == EWOULDBLOCK)
+            {
+                error = ::poll(&writable, 1, -1) < 0 && errno != EINTR ? errno : 0;
+            }
+            else if (errno != EINTR)
+            {
+                error = errno;
+            }
+            continue;
+        }
+
+        // A short write leaves it at the first string not written in full
+        for (; it != end && (size_t)n >= it->iov_len; ++it)
+        {
+            n -= it->iov_len;
+        }
+        if (n > 0)
+        {
+            it->iov_base = (char*)it->iov_base + n;
+            it->iov_len -= n;
+        }
+    }
+
+    _batch.clear();
+    _strings.clear();
+
+    if (error)
+    {
+        throw std::system_error(error, std::generic_category(), "writev");
+    }
+}
+
+SStringWriter::size_type SStringWriter::pending() const
+{
+    return _batch.size();
+}
+
+int SStringWriter::fd() const
+{
+    return _fd;
+}
@@ -0,0 +1,78 @@
+/*
+File: sstring_writer.h
+
+Copyright (c) 2018 Alexander DuPree
+
+This software is released as open source through the MIT License
+
+Authors: Alexander DuPree
+
+https://github.com/AlexanderJDupree/Python-Strings-for-CPP
+
+*/
+
+#ifndef SSTRING_WRITER_H
+#define SSTRING_WRITER_H
+
+#include <vector>
+#include <sys/uio.h>
+#include "sstring.h"
+
+// SStringWriter writes many SStrings to a file descriptor in few system
+// calls. Strings are gathered into a batch of iovecs pointing at their
+// characters, which one writev hands to the kernel, so no string is copied
+// into an intermediate buffer.
+//
+// The writer holds a reference to the buffer of each gathered string until
+// the batch is written, so temporaries and slices of buffers that are about
+// to be reused may be written. Immortal strings, such as literals, aren't
+// referenced since they are never released.
+// Writes to a non-blocking descriptor wait until it is writable.
+//
+// A writer is not thread safe.
+class SStringWriter
+{
+  public:
+
+    typedef SStringWriter self_type;
+    typedef SString::size_type size_type;
+
+    /****** CONSTRUCTORS ******/
+
+    // Writes to fd, writing a batch once batch_size strings are gathered.
+    // Throws std::invalid_argument if batch_size is 0
+    explicit SStringWriter(int fd, size_type batch_size = 1024);
+
+    // Writes the gathered strings, leaving fd open. Errors are ignored, call
+    // flush() first to see them
+    ~SStringWriter();
+
+    /****** WRITING ******/
+
+    // Gathers str, writing the batch if it is full. Throws std::system_error
+    // if writing fails, the batch is dropped
+    self_type& write(const SString& str);
+    self_type& operator<<(const SString& str);
+
+    // Writes the gathered strings. Throws std::system_error if writing fails,
+    // the batch is dropped
+    void flush();
+
+    // Returns the number of strings gathered and not yet written
+    size_type pending() const;
+
+    // Returns the descriptor written to
+    int fd() const;
+
+  private:
+
+    int _fd;
+    size_type _batch_size;
+    std::vector<iovec> _batch; // The characters of each gathered string
+    std::vector<SString> _strings; // Keeps the gathered buffers alive
+
+    SStringWriter(const self_type&);
+    self_type& operator=(const self_type&);
+};
+
+#endif // SSTRING_WRITER_H
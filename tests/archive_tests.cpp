@@ -0,0 +1,259 @@
+/*
+File: archive_tests.cpp
+
+Copyright (c) 2018 Alexander DuPree
+
+This software is released as open source through the MIT License
+
+Authors: Alexander DuPree
+
+https://github.com/AlexanderJDupree/Python-Strings-for-CPP
+
+*/
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+#include <vector>
+#include <unistd.h>
+#include "catch.hpp"
+#include "sstring_archive.h"
+#include "sstring_map.h"
+#include "sstring_writer.h"
+
+// A temporary file removed when the test ends
+struct temporary_path
+{
+    char path[32];
+
+    temporary_path()
+    {
+        std::snprintf(path, sizeof(path), "/tmp/sstring_archiveXXXXXX");
+        close(mkstemp(path));
+    }
+
+    ~temporary_path() { unlink(path); }
+};
+
+// Overwrites the byte at offset of the file at path
+static void corrupt(const char* path, long offset, char byte)
+{
+    std::FILE* file = std::fopen(path, "r+b");
+    std::fseek(file, offset, SEEK_SET);
+    std::fputc(byte, file);
+    std::fclose(file);
+}
+
+TEST_CASE("Archiving sequences of strings", "[SStringArchive]")
+{
+    temporary_path file;
+
+    SECTION("Strings load in order")
+    {
+        std::vector<SString> strings { "first", "", SString("nul\0byte", 8),
+                                       SString(300, 'x') };
+        SStringArchive::save(file.path, strings);
+
+        SStringArchive archive(file.path);
+
+        REQUIRE_FALSE(archive.is_map());
+        REQUIRE(archive.size() == 4);
+        for (unsigned i = 0; i < strings.size(); ++i)
+        {
+            REQUIRE(archive[i] == strings[i]);
+            REQUIRE(archive[i].length() == strings[i].length());
+        }
+        REQUIRE_THROWS_AS(archive[4], std::out_of_range);
+        REQUIRE_THROWS_AS(archive.key(0), std::out_of_range);
+    }
+    SECTION("Loaded strings view the mapping")
+    {
+        SStringArchive::save(file.path, std::vector<SString> { "mapped" });
+        SStringArchive archive(file.path);
+
+        SString str = archive[0];
+        SString copy(str);
+
+        REQUIRE_FALSE(str.is_immortal());
+        REQUIRE(str.c_str() == str.begin());
+        REQUIRE(copy.begin() == str.begin());
+        REQUIRE(str.hash() == SString::hash("mapped", 6));
+    }
+    SECTION("Loaded strings keep the mapping alive")
+    {
+        SStringArchive::save(file.path, std::vector<SString> { "kept", "dropped" });
+        SString kept;
+        {
+            SStringArchive archive(file.path);
+            kept = archive[0];
+            REQUIRE(kept.ref_count() == 2);
+        }
+
+        REQUIRE(kept.ref_count() == 1);
+        REQUIRE(kept == "kept");
+        REQUIRE(SString(kept) + "!" == "kept!");
+    }
+    SECTION("Strings outliving the archive never write to the mapping")
+    {
+        SStringArchive::save(file.path, std::vector<SString> { "hello world  ", 
+                                                               "second" });
+        SString str;
+        SString stripped;
+        {
+            SStringArchive archive(file.path);
+            str = archive[0];
+            stripped = archive[0].rstrip();
+        }
+
+        SString moved = std::move(str).rstrip();
+        REQUIRE(moved == "hello world");
+        REQUIRE(std::strcmp(moved.c_str(), "hello world") == 0);
+
+        REQUIRE(stripped.ref_count() == 1);
+        REQUIRE(std::strcmp(stripped.c_str(), "hello world") == 0);
+    }
+    SECTION("Maps and writers keep loaded strings past the archive")
+    {
+        SStringArchive::save(file.path, std::vector<SString> { "key", "line\n" });
+        int fds[2];
+        REQUIRE(pipe(fds) == 0);
+
+        SStringMap<int> map;
+        SStringWriter writer(fds[1]);
+        {
+            SStringArchive archive(file.path);
+            map[archive[0]] = 1;
+            writer << archive[1];
+        }
+        writer.flush();
+        close(fds[1]);
+
+        char buffer[8] = { 0 };
+        REQUIRE(read(fds[0], buffer, sizeof(buffer)) == 5);
+        REQUIRE(SString(buffer) == "line\n");
+        REQUIRE(map.at("key") == 1);
+        close(fds[0]);
+    }
+    SECTION("Empty sequences")
+    {
+        SStringArchive::save(file.path, std::vector<SString>());
+        SStringArchive archive(file.path);
+
+        REQUIRE(archive.size() == 0);
+    }
+}
+
+TEST_CASE("Archiving maps of strings", "[SStringArchive]")
+{
+    temporary_path file;
+
+    SECTION("Pairs are sorted by key and searchable")
+    {
+        SStringMap<SString> map;
+        map["host"] = "example.org";
+        map["accept"] = "*/*";
+        map["user-agent"] = "sstring";
+        map[""] = "empty key";
+        SStringArchive::save_map(file.path, map);
+
+        SStringArchive archive(file.path);
+        SString value;
+
+        REQUIRE(archive.is_map());
+        REQUIRE(archive.size() == 4);
+        REQUIRE(archive.key(0) == "");
+        REQUIRE(archive.key(1) == "accept");
+        REQUIRE(archive.value(1) == "*/*");
+        REQUIRE(archive.key(3) == "user-agent");
+
+        REQUIRE(archive.find("host", value));
+        REQUIRE(value == "example.org");
+        REQUIRE(archive.find("", value));
+        REQUIRE(value == "empty key");
+        REQUIRE_FALSE(archive.find("hos", value));
+        REQUIRE_FALSE(archive.find("hostname", value));
+        REQUIRE_THROWS_AS(archive[0], std::out_of_range);
+    }
+    SECTION("Keys with shared prefixes")
+    {
+        std::map<SString, SString> map;
+        for (int i = 0; i < 100; ++i)
+        {
+            SString key = SString("key") * (i % 7 + 1) + SString(i % 10 + 1, 'a' + i / 10);
+            map[key] = key + "!";
+        }
+        SStringArchive::save_map(file.path, map);
+
+        SStringArchive archive(file.path);
+        REQUIRE(archive.size() == map.size());
+
+        for (const std::pair<const SString, SString>& pair : map)
+        {
+            SString value;
+            REQUIRE(archive.find(pair.first, value));
+            REQUIRE(value == pair.second);
+        }
+    }
+    SECTION("Repeated keys are rejected")
+    {
+        std::vector<std::pair<SString, SString> > pairs { { "a", "1" }, { "a", "2" } };
+
+        REQUIRE_THROWS_AS(SStringArchive::save_map(file.path, pairs),
+                          std::invalid_argument);
+    }
+}
+
+TEST_CASE("Loading damaged archives", "[SStringArchive]")
+{
+    temporary_path file;
+    SStringArchive::save(file.path, std::vector<SString> { "one", "two" });
+
+    SECTION("Missing files")
+    {
+        REQUIRE_THROWS_AS(SStringArchive("/nonexistent/archive"), std::system_error);
+    }
+    SECTION("Changed characters fail the checksum")
+    {
+        corrupt(file.path, 64, 'x');
+
+        REQUIRE_THROWS_AS(SStringArchive(file.path), std::runtime_error);
+    }
+    SECTION("Other files are rejected")
+    {
+        corrupt(file.path, 0, 'X');
+
+        REQUIRE_THROWS_AS(SStringArchive(file.path), std::runtime_error);
+    }
+    SECTION("Truncated files are rejected")
+    {
+        REQUIRE(truncate(file.path, 40) == 0);
+        REQUIRE_THROWS_AS(SStringArchive(file.path), std::runtime_error);
+
+        REQUIRE(truncate(file.path, 0) == 0);
+        REQUIRE_THROWS_AS(SStringArchive(file.path), std::runtime_error);
+    }
+}
+
+#ifdef SSTRING_ENABLE_STATS
+
+TEST_CASE("Loading archives allocates no strings", "[SStringArchive]")
+{
+    temporary_path file;
+    SStringArchive::save(file.path, std::vector<SString> { "a", "b", "c" });
+
+    SStringStats::counters before = SStringStats::snapshot();
+    {
+        SStringArchive archive(file.path);
+        std::vector<SString> loaded { archive[0], archive[1], archive[2] };
+        REQUIRE(loaded[2] == "c");
+    }
+    SStringStats::counters after = SStringStats::snapshot();
+
+    REQUIRE(after.allocations == before.allocations);
+}
+
+#endif // SSTRING_ENABLE_STATS
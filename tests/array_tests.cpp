@@ -0,0 +1,254 @@
+/*
+File: array_tests.cpp
+
+Copyright (c) 2018 Alexander DuPree
+
+This software is released as open source through the MIT License
+
+Authors: Alexander DuPree
+
+https://github.com/AlexanderJDupree/Python-Strings-for-CPP
+
+*/
+
+#include <vector>
+#include "catch.hpp"
+#include "sstring_array.h"
+
+TEST_CASE("Constructing string arrays", "[SStringArray], [constructors]")
+{
+    SECTION("Default construction")
+    {
+        SStringArray column;
+
+        REQUIRE(column.empty());
+        REQUIRE(column.size() == 0);
+    }
+    SECTION("Initializer list construction")
+    {
+        SStringArray column { "one", "", "three" };
+
+        REQUIRE(column.size() == 3);
+        REQUIRE(column[0] == "one");
+        REQUIRE(column[1].empty());
+        REQUIRE(column[2] == "three");
+        REQUIRE(column.length(2) == 5);
+    }
+    SECTION("Range construction with SStrings")
+    {
+        std::vector<SString> values { "a", "bb", "ccc" };
+        SStringArray column(values);
+
+        REQUIRE(column.size() == 3);
+        REQUIRE(column[1] == "bb");
+    }
+    SECTION("Elements are slices of the shared buffer")
+    {
+        SStringArray column { "one", "two" };
+        SString first = column[0];
+        SString second = column[1];
+
+        REQUIRE(first.ref_count() == second.ref_count());
+        REQUIRE(first.ref_count() >= 3);
+        REQUIRE(second.end() - first.begin() == 4 + 3);
+    }
+    SECTION("Elements outlive the column")
+    {
+        SString value;
+        {
+            SStringArray column { "kept", "alive" };
+            value = column[1];
+        }
+
+        REQUIRE(value == "alive");
+        REQUIRE(*value.end() == '\0');
+    }
+#ifndef SSTRING_UNCHECKED
+    SECTION("Accessing out of bounds element")
+    {
+        SStringArray column { "one" };
+
+        REQUIRE_THROWS_AS(column[1], bad_index);
+    }
+#endif
+    SECTION("Accessing elements without exceptions")
+    {
+        SStringArray column { "one", "two" };
+
+        REQUIRE(column.try_at(1).value() == "two");
+        REQUIRE_FALSE(column.try_at(2));
+    }
+}
+
+TEST_CASE("Batch string operations", "[SStringArray], [operations]")
+{
+    SECTION("strip every value")
+    {
+        SStringArray column { "  a  ", "b  ", "    ", "c" };
+        SStringArray stripped = column.strip(' ');
+
+        REQUIRE(stripped.size() == 4);
+        REQUIRE(stripped[0] == "a");
+        REQUIRE(stripped[1] == "b");
+        REQUIRE(stripped[2].empty());
+        REQUIRE(stripped[3] == "c");
+    }
+    SECTION("strip with the null terminator")
+    {
+        SStringArray column { "a" };
+
+        REQUIRE_THROWS_AS(column.strip('\0'), std::invalid_argument);
+    }
+    SECTION("substring every value")
+    {
+        SStringArray column { "Hello World", "Howdy" };
+        SStringArray sub = column.substring(1, 3);
+
+        REQUIRE(sub[0] == "ell");
+        REQUIRE(sub[1] == "owd");
+    }
+    SECTION("substring out of bounds for one value")
+    {
+        SStringArray column { "Hello World", "Hi" };
+
+        REQUIRE_THROWS_AS(column.substring(1, 3), invalid_substring);
+    }
+    SECTION("is_upper on every value")
+    {
+        SStringArray column { "HELLO", "hello", "!@#T", "" };
+        SStringArray::mask_type mask = column.is_upper();
+
+        REQUIRE(mask[0]);
+        REQUIRE_FALSE(mask[1]);
+        REQUIRE(mask[2]);
+        REQUIRE(mask[3]);
+    }
+    SECTION("isnumeric agrees with SString::isnumeric")
+    {
+        SStringArray column { "1234", "0b0101", "0o1276", "0xaEf", "ab123",
+                              "0b012", "0o8", "0xg", "", "0b" };
+        SStringArray::mask_type mask = column.isnumeric();
+
+        for (size_t i = 0; i < column.size(); ++i)
+        {
+            REQUIRE(mask[i] == column[i].isnumeric());
+        }
+    }
+}
+
+TEST_CASE("Batch search predicates", "[SStringArray], [search]")
+{
+    SStringArray column { "api/v1/users", "api/v2/items", "static/app.js", "" };
+
+    SECTION("startswith")
+    {
+        SStringArray::mask_type mask = column.startswith("api/");
+
+        REQUIRE(mask == SStringArray::mask_type { true, true, false, false });
+    }
+    SECTION("endswith")
+    {
+        SStringArray::mask_type mask = column.endswith(".js");
+
+        REQUIRE(mask == SStringArray::mask_type { false, false, true, false });
+    }
+    SECTION("contains")
+    {
+        SStringArray::mask_type mask = column.contains("v2");
+
+        REQUIRE(mask == SStringArray::mask_type { false, true, false, false });
+    }
+    SECTION("Masks are bytes that combine element-wise")
+    {
+        SStringArray::mask_type api = column.startswith("api/");
+        SStringArray::mask_type v2 = column.contains("v2");
+        const unsigned char* bytes = v2.data();
+
+        for (size_t i = 0; i < api.size(); ++i)
+        {
+            api[i] &= bytes[i];
+        }
+
+        REQUIRE(api == SStringArray::mask_type { 0, 1, 0, 0 });
+    }
+    SECTION("contains an empty needle")
+    {
+        SStringArray::mask_type mask = column.contains("");
+
+        REQUIRE(mask == SStringArray::mask_type { true, true, true, true });
+    }
+}
+
+TEST_CASE("Batch comparisons", "[SStringArray], [comparison]")
+{
+    SStringArray column { "apple", "banana", "app", "cherry" };
+
+    SECTION("equal and not_equal")
+    {
+        REQUIRE(column.equal("app") ==
+                SStringArray::mask_type { false, false, true, false });
+        REQUIRE(column.not_equal("app") ==
+                SStringArray::mask_type { true, true, false, true });
+    }
+    SECTION("less and greater")
+    {
+        REQUIRE(column.less("apple") ==
+                SStringArray::mask_type { false, false, true, false });
+        REQUIRE(column.greater("apple") ==
+                SStringArray::mask_type { false, true, false, true });
+    }
+    SECTION("element-wise equality between columns")
+    {
+        SStringArray other { "apple", "Banana", "app" };
+
+        REQUIRE(column.equal(other) ==
+                SStringArray::mask_type { true, false, true, false });
+    }
+}
+
+TEST_CASE("Scoring a query against every element", "[SStringArray]")
+{
+    std::vector<SString> names;
+    for (int i = 0; i < 1000; ++i)
+    {
+        names.push_back(SString("catalog item ") + SString(i % 26 + 1, 'a' + i % 26));
+    }
+    SStringArray column(names);
+    SString query("catalog item ccc");
+
+    SECTION("Edit distances")
+    {
+        std::vector<SStringArray::size_type> single = column.levenshtein(query, SString::npos, 1);
+        std::vector<SStringArray::size_type> parallel = column.levenshtein(query, SString::npos, 4);
+
+        REQUIRE(single == parallel);
+        for (SStringArray::size_type i = 0; i < names.size(); ++i)
+        {
+            REQUIRE(single[i] == names[i].levenshtein(query));
+        }
+        REQUIRE(single[2] == 0);
+    }
+    SECTION("Bounded edit distances")
+    {
+        std::vector<SStringArray::size_type> bounded = column.levenshtein(query, 2);
+
+        for (SStringArray::size_type i = 0; i < names.size(); ++i)
+        {
+            REQUIRE(bounded[i] == names[i].levenshtein(query, 2));
+        }
+    }
+    SECTION("Similarity ratios")
+    {
+        std::vector<double> ratios = column.similarity_ratio(query, 3);
+
+        for (SStringArray::size_type i = 0; i < names.size(); ++i)
+        {
+            REQUIRE(ratios[i] == names[i].similarity_ratio(query));
+        }
+    }
+    SECTION("Empty columns")
+    {
+        REQUIRE(SStringArray().levenshtein(query).empty());
+        REQUIRE(SStringArray().similarity_ratio(query).empty());
+    }
+}
@@ -0,0 +1,130 @@
+/*
+File: glob_tests.cpp
+
+Copyright (c) 2018 Alexander DuPree
+
+This software is released as open source through the MIT License
+
+Authors: Alexander DuPree
+
+https://github.com/AlexanderJDupree/Python-Strings-for-CPP
+
+*/
+
+#include <cstdlib>
+#include <fnmatch.h>
+#include <stdexcept>
+#include <vector>
+#include "catch.hpp"
+#include "sstring_glob.h"
+
+// Returns a random string of up to max_length characters from alphabet
+static SString random_string(const char* alphabet, unsigned max_length)
+{
+    unsigned n = std::rand() % (max_length + 1);
+    SString str(n, ' ');
+    for (unsigned i = 0; i < n; ++i)
+    {
+        const_cast<char*>(str.begin())[i] = alphabet[std::rand() % std::strlen(alphabet)];
+    }
+    return str;
+}
+
+TEST_CASE("Shell-style wildcard matching", "[SStringGlob]")
+{
+    SECTION("Wildcards and sequences")
+    {
+        SStringGlob glob { "*.log", "api/v?/users/*", "[a-c]x[!0-9]" };
+
+        REQUIRE(glob.find("server.log") == 0);
+        REQUIRE(glob.find(".log") == 0);
+        REQUIRE(glob.find("api/v2/users/42") == 1);
+        REQUIRE(glob.find("api/v2/users/") == 1);
+        REQUIRE(glob.find("api/v10/users/42") == SString::npos);
+        REQUIRE(glob.find("bxy") == 2);
+        REQUIRE_FALSE(glob.match("bx7"));
+        REQUIRE_FALSE(glob.match("dxy"));
+        REQUIRE_FALSE(glob.match("server.log.1"));
+    }
+    SECTION("Every matching pattern is reported")
+    {
+        SStringGlob glob { "*", "a*", "*z", "b*" };
+        std::vector<size_t> ids = glob.match_all("abz");
+
+        REQUIRE(ids == std::vector<size_t>({ 0, 1, 2 }));
+        REQUIRE(glob.match_all("") == std::vector<size_t>({ 0 }));
+    }
+    SECTION("Escapes, literal brackets and a leading ]")
+    {
+        SStringGlob glob { "\\*", "[]]", "[!]]", "[", "a[b" };
+
+        REQUIRE(glob.find("*") == 0);
+        REQUIRE(glob.find("]") == 1);
+        REQUIRE(glob.find("x") == 2);
+        REQUIRE(glob.match_all("[") == std::vector<size_t>({ 2, 3 }));
+        REQUIRE(glob.find("a[b") == 4);
+        REQUIRE_FALSE(glob.match("ab"));
+    }
+    SECTION("Pathname and casefold options")
+    {
+        SStringGlob paths({ "src/*.cpp" }, SStringGlob::pathname);
+        SStringGlob names({ "*.CPP", "[a-c]*" }, SStringGlob::casefold);
+
+        REQUIRE(paths.match("src/sstring.cpp"));
+        REQUIRE_FALSE(paths.match("src/detail/sstring.cpp"));
+        REQUIRE(SStringGlob({ "src/*.cpp" }).match("src/detail/sstring.cpp"));
+        REQUIRE(names.match("sstring.cpp"));
+        REQUIRE(names.find("Build") == 1);
+    }
+    SECTION("No patterns match nothing")
+    {
+        SStringGlob glob(std::vector<SString>{});
+
+        REQUIRE(glob.size() == 0);
+        REQUIRE_FALSE(glob.match(""));
+    }
+    SECTION("Agrees with fnmatch on random patterns")
+    {
+        std::srand(2018);
+        for (int trial = 0; trial < 300; ++trial)
+        {
+            SString pattern = random_string("ab/*?[]!-", 8);
+            int flags = trial % 2 ? SStringGlob::pathname : SStringGlob::none;
+            SStringGlob glob({ pattern }, flags);
+
+            for (int i = 0; i < 20; ++i)
+            {
+                SString text = random_string("ab/-]!", 8);
+                bool expected = ::fnmatch(pattern, text, 
+                                          trial % 2 ? FNM_PATHNAME : 0) == 0;
+                INFO(pattern << " " << text);
+                REQUIRE(glob.match(text) == expected);
+                REQUIRE(SStringGlob::match_once(pattern, text, flags) == expected);
+            }
+        }
+    }
+    SECTION("Patterns that need too many states are refused")
+    {
+        REQUIRE_THROWS_AS(SStringGlob({ "*a??????????????" }), std::length_error);
+    }
+}
+
+TEST_CASE("Python style fnmatch", "[SString], [fnmatch]")
+{
+    SString file("access.log");
+
+    REQUIRE(file.fnmatch("*.log"));
+    REQUIRE(file.fnmatch("access.???"));
+    REQUIRE_FALSE(file.fnmatch("*.txt"));
+    REQUIRE(file.fnmatch(SStringGlob { "*.txt", "a*" }));
+
+    SECTION("Patterns that need too many states still match")
+    {
+        const char* pattern = "*a??????????????";
+
+        REQUIRE_FALSE(SString("xxab").fnmatch(pattern));
+        REQUIRE(SString("xxabcdefghijklmno").fnmatch(pattern));
+        REQUIRE_FALSE(SString("xxabcdefghijklmnop").fnmatch(pattern));
+        REQUIRE(SString("xxaaaaaaaaaaaaaaaaaaaa").fnmatch(pattern));
+    }
+}
@@ -0,0 +1,224 @@
+/*
+File: map_tests.cpp
+
+Copyright (c) 2018 Alexander DuPree
+
+This software is released as open source through the MIT License
+
+Authors: Alexander DuPree
+
+https://github.com/AlexanderJDupree/Python-Strings-for-CPP
+
+*/
+
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+#include "catch.hpp"
+#include "sstring_map.h"
+
+#if __cplusplus >= 201703L
+#include <string_view>
+#endif
+
+TEST_CASE("Mapping SString keys to values", "[SStringMap]")
+{
+    SECTION("Default construction allocates no slots")
+    {
+        SStringMap<int> map;
+
+        REQUIRE(map.empty());
+        REQUIRE(map.capacity() == 0);
+        REQUIRE(map.find("missing") == map.end());
+        REQUIRE(map.begin() == map.end());
+    }
+    SECTION("Initializer list construction")
+    {
+        SStringMap<int> map { { "one", 1 }, { "two", 2 }, { "three", 3 } };
+
+        REQUIRE(map.size() == 3);
+        REQUIRE(map.at("two") == 2);
+        REQUIRE(map.find("three")->second == 3);
+        REQUIRE_THROWS_AS(map.at("four"), std::out_of_range);
+    }
+    SECTION("Lookups by SString, c-string and slice")
+    {
+        SStringMap<int> map;
+        map[SString("key")] = 1;
+        SString text = "  key=value";
+
+        REQUIRE(map.contains("key"));
+        REQUIRE(map.contains(SString("key")));
+        REQUIRE(map.count(std::get<0>(text.strip().partition("="))) == 1);
+        REQUIRE_FALSE(map.contains(std::get<0>(text.partition("="))));
+        REQUIRE_FALSE(map.contains(""));
+    }
+#if __cplusplus >= 201703L
+    SECTION("Lookups by string view")
+    {
+        SStringMap<int> map { { "alpha", 1 } };
+        std::string_view view("alphabet", 5);
+
+        REQUIRE(map.at(view) == 1);
+        REQUIRE(map.erase(view) == 1);
+        REQUIRE(map.empty());
+    }
+#endif
+    SECTION("Keys are shared with the SString they were inserted from")
+    {
+        SString key = "shared";
+        SStringMap<int> map;
+        map.emplace(key, 7);
+
+        REQUIRE(map.begin()->first.begin() == key.begin());
+    }
+    SECTION("operator[] inserts default values once")
+    {
+        SStringMap<int> map;
+        ++map["hits"];
+        ++map["hits"];
+
+        REQUIRE(map.size() == 1);
+        REQUIRE(map["hits"] == 2);
+    }
+    SECTION("emplace and insert don't replace existing values")
+    {
+        SStringMap<SString> map;
+
+        REQUIRE(map.emplace("key", "first").second);
+        REQUIRE_FALSE(map.insert("key", "second").second);
+        REQUIRE(map.at("key") == "first");
+    }
+    SECTION("Random insertions and erasures match std::unordered_map")
+    {
+        std::srand(36);
+        SStringMap<int> map;
+        std::unordered_map<std::string, int> expected;
+
+        for (int i = 0; i < 20000; ++i)
+        {
+            std::string key = std::to_string(std::rand() % 2000);
+            if (std::rand() % 3)
+            {
+                map[key.c_str()] = i;
+                expected[key] = i;
+            }
+            else
+            {
+                REQUIRE(map.erase(key.c_str()) == expected.erase(key));
+            }
+        }
+
+        REQUIRE(map.size() == expected.size());
+        for (const std::pair<const std::string, int>& entry : expected)
+        {
+            REQUIRE(map.at(entry.first.c_str()) == entry.second);
+        }
+
+        std::size_t visited = 0;
+        for (const std::pair<const SString, int>& entry : map)
+        {
+            REQUIRE(expected.at(entry.first.c_str()) == entry.second);
+            ++visited;
+        }
+        REQUIRE(visited == expected.size());
+    }
+    SECTION("Deleted slots are reclaimed instead of growing the table")
+    {
+        SStringMap<int> map;
+        map.reserve(100);
+        std::size_t capacity = map.capacity();
+
+        for (int round = 0; round < 100; ++round)
+        {
+            for (int i = 0; i < 100; ++i)
+            {
+                map[std::to_string(round * 100 + i).c_str()] = i;
+            }
+            for (int i = 0; i < 100; ++i)
+            {
+                map.erase(std::to_string(round * 100 + i).c_str());
+            }
+        }
+
+        REQUIRE(map.empty());
+        REQUIRE(map.capacity() <= capacity * 2);
+    }
+    SECTION("Copies are independent, moves leave an empty map")
+    {
+        SStringMap<int> map { { "a", 1 }, { "b", 2 } };
+        SStringMap<int> copy(map);
+        copy["c"] = 3;
+        map.erase("a");
+
+        REQUIRE(copy.size() == 3);
+        REQUIRE(copy.at("a") == 1);
+        REQUIRE(map.size() == 1);
+
+        SStringMap<int> moved(std::move(copy));
+        REQUIRE(moved.size() == 3);
+        REQUIRE(copy.empty());
+
+        map = moved;
+        REQUIRE(map.at("c") == 3);
+    }
+    SECTION("Clearing keeps the slots")
+    {
+        SStringMap<int> map { { "a", 1 } };
+        std::size_t capacity = map.capacity();
+        map.clear();
+
+        REQUIRE(map.empty());
+        REQUIRE(map.capacity() == capacity);
+        REQUIRE_FALSE(map.contains("a"));
+    }
+}
+
+TEST_CASE("Sets of SStrings", "[SStringSet]")
+{
+    SECTION("Initializer list and range construction")
+    {
+        SStringSet set { "a", "b", "a" };
+        std::vector<SString> words { "x", "y", "z", "x" };
+        SStringSet from_range(words);
+
+        REQUIRE(set.size() == 2);
+        REQUIRE(from_range.size() == 3);
+        REQUIRE(from_range.contains("z"));
+    }
+    SECTION("Insertion reports duplicates")
+    {
+        SStringSet set;
+
+        REQUIRE(set.insert("word").second);
+        REQUIRE_FALSE(set.insert(SString("word")).second);
+        REQUIRE(*set.find("word") == "word");
+        REQUIRE(set.find("other") == set.end());
+    }
+    SECTION("Erasure")
+    {
+        SStringSet set { "a", "b" };
+
+        REQUIRE(set.erase("a") == 1);
+        REQUIRE(set.erase("a") == 0);
+        REQUIRE(set.count("b") == 1);
+        REQUIRE(set.size() == 1);
+    }
+    SECTION("Growth keeps every element")
+    {
+        SStringSet set;
+        for (int i = 0; i < 5000; ++i)
+        {
+            set.insert(std::to_string(i).c_str());
+        }
+
+        REQUIRE(set.size() == 5000);
+        for (int i = 0; i < 5000; ++i)
+        {
+            REQUIRE(set.contains(std::to_string(i).c_str()));
+        }
+    }
+}
@@ -0,0 +1,152 @@
+/*
+File: matcher_tests.cpp
+
+Copyright (c) 2018 Alexander DuPree
+
+This software is released as open source through the MIT License
+
+Authors: Alexander DuPree
+
+https://github.com/AlexanderJDupree/Python-Strings-for-CPP
+
+*/
+
+#include <algorithm>
+#include <vector>
+#include "catch.hpp"
+#include "sstring_matcher.h"
+
+// Finds every occurrence of every pattern one pattern at a time
+static std::vector<std::pair<size_t, size_t> > 
+naive_find_all(const SString& text, const std::vector<SString>& patterns)
+{
+    std::vector<std::pair<size_t, size_t> > matches;
+    for (size_t end = 1; end <= text.length(); ++end)
+    {
+        for (size_t p = 0; p < patterns.size(); ++p)
+        {
+            size_t n = patterns[p].length();
+            if (n && n <= end && 
+                std::memcmp(text.begin() + end - n, patterns[p].begin(), n) == 0)
+            {
+                matches.push_back(std::make_pair(end - n, p));
+            }
+        }
+    }
+    return matches;
+}
+
+TEST_CASE("Multi-pattern matching", "[SStringMatcher]")
+{
+    SECTION("The classic he/she/his/hers example")
+    {
+        SStringMatcher matcher { "he", "she", "his", "hers" };
+        std::vector<SStringMatcher::match> matches = matcher.find_all("ushers");
+
+        REQUIRE(matches.size() == 3);
+        REQUIRE(matches[0].position == 1);
+        REQUIRE(matches[0].pattern == 1);
+        REQUIRE(matches[1].position == 2);
+        REQUIRE(matches[1].pattern == 0);
+        REQUIRE(matches[2].position == 2);
+        REQUIRE(matches[2].pattern == 3);
+    }
+    SECTION("Agrees with a search per pattern")
+    {
+        std::vector<SString> patterns { "a", "ab", "bab", "bc", "bca", "c", 
+                                        "caa", "aaaa", "abcab" };
+        SStringMatcher matcher(patterns);
+        SString text("abccab aaaaa bcabcaabcab cbabcaaa");
+
+        std::vector<std::pair<size_t, size_t> > expected = 
+            naive_find_all(text, patterns);
+        std::vector<SStringMatcher::match> matches = matcher.find_all(text);
+
+        REQUIRE(matches.size() == expected.size());
+
+        // Matches ending at the same position may be reported in any order
+        std::vector<std::pair<size_t, size_t> > found;
+        for (const SStringMatcher::match& m : matches)
+        {
+            found.push_back(std::make_pair(m.position, m.pattern));
+        }
+        std::sort(found.begin(), found.end());
+        std::sort(expected.begin(), expected.end());
+        REQUIRE(found == expected);
+    }
+    SECTION("Bytes outside the patterns' alphabet")
+    {
+        SStringMatcher matcher { "\xff\x01", "zz" };
+
+        REQUIRE(matcher.contains("abc\xff\x01"));
+        REQUIRE_FALSE(matcher.contains("abc\xff\x02z"));
+    }
+    SECTION("find prefers the leftmost then longest occurrence")
+    {
+        SStringMatcher matcher { "cd", "bcd", "bc", "xyz" };
+        SStringMatcher::match found = matcher.find("abcdxyz");
+
+        REQUIRE(found.position == 1);
+        REQUIRE(found.pattern == 1);
+        REQUIRE(matcher.find("nothing here").position == SString::npos);
+    }
+    SECTION("An empty pattern matches everywhere")
+    {
+        SStringMatcher matcher { "", "b" };
+
+        REQUIRE(matcher.find_all("ab").size() == 4);
+        REQUIRE(matcher.find("ab").position == 0);
+        REQUIRE(matcher.match_prefix("xyz"));
+        REQUIRE(matcher.match_suffix("xyz"));
+    }
+}
+
+TEST_CASE("Python style prefix and suffix tests", "[SString], [startswith], [endswith]")
+{
+    SString path("api/v2/users/42.json");
+
+    SECTION("A single prefix or suffix")
+    {
+        REQUIRE(path.startswith("api/"));
+        REQUIRE_FALSE(path.startswith("static/"));
+        REQUIRE(path.endswith(".json"));
+        REQUIRE_FALSE(path.endswith(".xml"));
+        REQUIRE(path.startswith(""));
+        REQUIRE_FALSE(SString("ap").startswith("api"));
+    }
+    SECTION("A tuple of prefixes or suffixes")
+    {
+        REQUIRE(path.startswith({ "static/", "api/" }));
+        REQUIRE_FALSE(path.startswith({ "static/", "img/" }));
+        REQUIRE(path.endswith({ ".xml", ".json" }));
+        REQUIRE_FALSE(path.endswith({ ".xml", ".html" }));
+    }
+    SECTION("A compiled set of prefixes or suffixes")
+    {
+        SStringMatcher prefixes { "static/", "api/v1/", "api/v2/", "a" };
+        SStringMatcher suffixes { ".xml", "son", ".html" };
+
+        REQUIRE(path.startswith(prefixes));
+        REQUIRE(SString("ab").startswith(prefixes));
+        REQUIRE_FALSE(SString("api/v3/").startswith(SStringMatcher { "api/v1/", "api/v2/" }));
+        REQUIRE(path.endswith(suffixes));
+        REQUIRE_FALSE(SString("on").endswith(suffixes));
+    }
+    SECTION("A prefix reached through a suffix link is not a prefix")
+    {
+        SStringMatcher prefixes { "xab", "abc" };
+
+        REQUIRE_FALSE(SString("xabc").startswith(SStringMatcher { "abc" }));
+        REQUIRE(SString("xabd").startswith(prefixes));
+        REQUIRE_FALSE(SString("xa").startswith(prefixes));
+    }
+}
+
+TEST_CASE("Finding any of several patterns", "[SString], [find_any]")
+{
+    SString line("2018-06-15 WARN disk almost full, ERROR soon");
+
+    REQUIRE(line.find_any({ "ERROR", "WARN" }) == 11);
+    REQUIRE(line.find_any(SStringMatcher { "FATAL", "full" }) == 28);
+    REQUIRE(line.find_any({ "FATAL" }) == SString::npos);
+}
@@ -0,0 +1,188 @@
+/*
+File: reader_tests.cpp
+
+Copyright (c) 2018 Alexander DuPree
+
+This software is released as open source through the MIT License
+
+Authors: Alexander DuPree
+
+https://github.com/AlexanderJDupree/Python-Strings-for-CPP
+
+*/
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+#include <unistd.h>
+#include "catch.hpp"
+#include "sstring_line_reader.h"
+
+// Writes str to fd in full
+static void write_all(int fd, const char* str)
+{
+    std::size_t n = std::strlen(str);
+    REQUIRE(write(fd, str, n) == (ssize_t)n);
+}
+
+TEST_CASE("Reading lines from pipes", "[SStringLineReader]")
+{
+    int fds[2];
+    REQUIRE(pipe(fds) == 0);
+
+    std::vector<SString> lines;
+    SStringLineReader reader(16);
+    reader.add(fds[0], [&lines](int, const SString& line) {
+        lines.push_back(line);
+    });
+
+    SECTION("Lines split across writes are joined")
+    {
+        write_all(fds[1], "first\nsec");
+        REQUIRE(reader.poll() == 1);
+        REQUIRE(lines.size() == 1);
+
+        write_all(fds[1], "ond\n\nthird");
+        reader.poll();
+        close(fds[1]);
+        reader.run();
+
+        REQUIRE(lines.size() == 4);
+        REQUIRE(lines[0] == "first");
+        REQUIRE(lines[1] == "second");
+        REQUIRE(lines[2] == "");
+        REQUIRE(lines[3] == "third");
+        REQUIRE(reader.size() == 0);
+    }
+    SECTION("Lines longer than a chunk grow it")
+    {
+        write_all(fds[1], "a line much longer than sixteen bytes\nshort\n");
+        close(fds[1]);
+        reader.run();
+
+        REQUIRE(lines.size() == 2);
+        REQUIRE(lines[0] == "a line much longer than sixteen bytes");
+        REQUIRE(lines[1] == "short");
+    }
+    SECTION("Lines are slices of the chunk they were read into")
+    {
+        write_all(fds[1], "one\ntwo\n");
+        reader.poll();
+
+        REQUIRE(lines.size() == 2);
+        REQUIRE(lines[0].ref_count() == lines[1].ref_count());
+        REQUIRE(lines[0].ref_count() == 3);
+
+        // Retained lines outlive the chunk being reused
+        write_all(fds[1], "three and four\n");
+        close(fds[1]);
+        reader.run();
+
+        REQUIRE(lines[0] == "one");
+        REQUIRE(lines[1] == "two");
+        REQUIRE(lines[2] == "three and four");
+    }
+    SECTION("Newlines found by the block scan")
+    {
+        write_all(fds[1], "0123456789\n0123456789abcdef\n0\n1\n");
+        close(fds[1]);
+
+        SStringLineReader wide;
+        wide.add(fds[0], [&lines](int, const SString& line) {
+            lines.push_back(line);
+        });
+        reader.remove(fds[0]);
+        wide.run();
+
+        REQUIRE(lines.size() == 4);
+        REQUIRE(lines[1] == "0123456789abcdef");
+        REQUIRE(lines[3] == "1");
+    }
+    SECTION("Watching a descriptor twice throws")
+    {
+        REQUIRE_THROWS_AS(reader.add(fds[0], SStringLineReader::callback_type()),
+                          std::invalid_argument);
+        close(fds[1]);
+    }
+
+    close(fds[0]);
+}
+
+TEST_CASE("Reading many descriptors", "[SStringLineReader]")
+{
+    int first[2];
+    int second[2];
+    REQUIRE(pipe(first) == 0);
+    REQUIRE(pipe(second) == 0);
+
+    std::vector<SString> lines;
+    SStringLineReader reader;
+
+    SECTION("Each descriptor keeps its own partial line")
+    {
+        SStringLineReader::callback_type collect = [&](int fd, const SString& line) {
+            lines.push_back(SString(fd == first[0] ? "first: " : "second: ") + line);
+        };
+        reader.add(first[0], collect);
+        reader.add(second[0], collect);
+
+        write_all(first[1], "a");
+        write_all(second[1], "b\n");
+        reader.poll();
+        write_all(first[1], "c\n");
+        close(first[1]);
+        close(second[1]);
+        reader.run();
+
+        REQUIRE(lines.size() == 2);
+        REQUIRE(lines[0] == "second: b");
+        REQUIRE(lines[1] == "first: ac");
+    }
+    SECTION("A callback may stop watching its descriptor")
+    {
+        reader.add(first[0], [&](int fd, const SString& line) {
+            lines.push_back(line);
+            reader.remove(fd);
+        });
+        reader.add(second[0], [&](int, const SString& line) {
+            lines.push_back(line);
+        });
+
+        write_all(first[1], "stop\nignored\n");
+        write_all(second[1], "kept\n");
+        close(first[1]);
+        close(second[1]);
+        reader.run();
+
+        REQUIRE(lines.size() == 2);
+        REQUIRE(std::count(lines.begin(), lines.end(), SString("stop")) == 1);
+        REQUIRE(std::count(lines.begin(), lines.end(), SString("kept")) == 1);
+    }
+
+    close(first[0]);
+    close(second[0]);
+}
+
+TEST_CASE("Reading lines from a file", "[SStringLineReader]")
+{
+    std::FILE* file = std::tmpfile();
+    REQUIRE(file != NULL);
+    std::fputs("header\nrow 1\nrow 2", file);
+    std::fflush(file);
+    std::rewind(file);
+
+    std::vector<SString> lines;
+    SStringLineReader reader(8);
+    reader.add(fileno(file), [&lines](int, const SString& line) {
+        lines.push_back(line);
+    });
+    reader.run();
+
+    REQUIRE(lines.size() == 3);
+    REQUIRE(lines[0] == "header");
+    REQUIRE(lines[2] == "row 2");
+
+    std::fclose(file);
+}
@@ -0,0 +1,118 @@
+/*
+File: sort_tests.cpp
+
+Copyright (c) 2018 Alexander DuPree
+
+This software is released as open source through the MIT License
+
+Authors: Alexander DuPree
+
+https://github.com/AlexanderJDupree/Python-Strings-for-CPP
+
+*/
+
+#include <algorithm>
+#include <cstdlib>
+#include <deque>
+#include <vector>
+#include "catch.hpp"
+#include "sstring_sort.h"
+
+// Returns n random strings sharing long prefixes, from an alphabet that
+// includes the null character
+static std::vector<SString> random_strings(unsigned n)
+{
+    const char alphabet[] = { '\0', 'a', 'b', '\xff' };
+    std::vector<SString> strings;
+
+    for (unsigned i = 0; i < n; ++i)
+    {
+        unsigned length = std::rand() % 24;
+        SString str(length, 'p');
+        for (unsigned j = length / 2; j < length; ++j)
+        {
+            const_cast<char*>(str.begin())[j] = alphabet[std::rand() % 4];
+        }
+        strings.push_back(SString(str.begin(), length));
+    }
+
+    return strings;
+}
+
+// Tests that both sequences hold the same strings in the same buffers
+static bool same_buffers(const std::vector<SString>& lhs,
+                         const std::vector<SString>& rhs)
+{
+    for (std::size_t i = 0; i < lhs.size(); ++i)
+    {
+        if (lhs[i].begin() != rhs[i].begin())
+        {
+            return false;
+        }
+    }
+    return lhs.size() == rhs.size();
+}
+
+TEST_CASE("Sorting sequences of SStrings", "[sstring_sort]")
+{
+    std::srand(37);
+
+    SECTION("Empty and single element ranges")
+    {
+        std::vector<SString> strings;
+        sstring_sort(strings.begin(), strings.end());
+        REQUIRE(strings.empty());
+
+        strings.push_back("only");
+        sstring_stable_sort(strings.begin(), strings.end());
+        REQUIRE(strings[0] == "only");
+    }
+    SECTION("Orders strings as operator< does")
+    {
+        std::vector<SString> strings = random_strings(5000);
+        std::vector<SString> expected = strings;
+
+        std::sort(expected.begin(), expected.end());
+        sstring_sort(strings.begin(), strings.end());
+
+        REQUIRE(std::equal(strings.begin(), strings.end(), expected.begin()));
+    }
+    SECTION("Strings differing only in trailing null characters")
+    {
+        std::vector<SString> strings { SString("ab\0\0", 4), SString("ab", 2),
+                                       SString("ab\0", 3), SString("a", 1) };
+        sstring_sort(strings.begin(), strings.end());
+
+        REQUIRE(strings[0].length() == 1);
+        REQUIRE(strings[1].length() == 2);
+        REQUIRE(strings[2].length() == 3);
+        REQUIRE(strings[3].length() == 4);
+    }
+    SECTION("Stable sorting keeps equal strings in order")
+    {
+        std::vector<SString> strings = random_strings(5000);
+        std::vector<SString> expected = strings;
+
+        std::stable_sort(expected.begin(), expected.end());
+        sstring_stable_sort(strings.begin(), strings.end());
+
+        REQUIRE(same_buffers(strings, expected));
+    }
+    SECTION("Parallel sorting")
+    {
+        std::vector<SString> strings = random_strings(200000);
+        std::vector<SString> expected = strings;
+
+        std::stable_sort(expected.begin(), expected.end());
+        sstring_stable_sort(strings.begin(), strings.end(), sstring_parallel);
+
+        REQUIRE(same_buffers(strings, expected));
+    }
+    SECTION("Random access ranges that aren't contiguous")
+    {
+        std::deque<SString> strings { "pear", "apple", "fig", "apple" };
+        sstring_sort(strings.begin(), strings.end());
+
+        REQUIRE(strings == std::deque<SString>({ "apple", "apple", "fig", "pear" }));
+    }
+}
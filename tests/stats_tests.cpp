@@ -0,0 +1,129 @@
+/*
+File: stats_tests.cpp
+
+Copyright (c) 2018 Alexander DuPree
+
+This software is released as open source through the MIT License
+
+Authors: Alexander DuPree
+
+https://github.com/AlexanderJDupree/Python-Strings-for-CPP
+
+*/
+
+#include <sstream>
+#include <thread>
+#include "catch.hpp"
+#include "sstring.h"
+
+#ifdef SSTRING_ENABLE_STATS
+
+TEST_CASE("Recording allocation statistics", "[SStringStats]")
+{
+    REQUIRE(SStringStats::enabled());
+
+    SECTION("Allocating and releasing a string")
+    {
+        SStringStats::counters before = SStringStats::snapshot();
+        {
+            SString str("Hello");
+            SStringStats::counters during = SStringStats::snapshot();
+
+            REQUIRE(during.allocations - before.allocations == 1);
+            REQUIRE(during.live_buffers - before.live_buffers == 1);
+            REQUIRE(during.deep_copies - before.deep_copies == 1);
+            REQUIRE(during.length_histogram[3] - before.length_histogram[3] == 1);
+        }
+        SStringStats::counters after = SStringStats::snapshot();
+
+        REQUIRE(after.frees - before.frees == 1);
+        REQUIRE(after.live_buffers == before.live_buffers);
+        REQUIRE(after.live_bytes == before.live_bytes);
+    }
+    SECTION("Copies share the buffer")
+    {
+        SString str("shared");
+        SStringStats::counters before = SStringStats::snapshot();
+
+        SString first(str);
+        SString second(str);
+        SStringStats::counters after = SStringStats::snapshot();
+
+        REQUIRE(after.shared_copies - before.shared_copies == 2);
+        REQUIRE(after.allocations == before.allocations);
+        REQUIRE(after.ref_count_histogram[2] - before.ref_count_histogram[2] == 2);
+    }
+    SECTION("Immortal literals are never counted")
+    {
+        SStringStats::counters before = SStringStats::snapshot();
+        {
+            SString str = "literal"_ss;
+            SString copy(str);
+        }
+        SStringStats::counters after = SStringStats::snapshot();
+
+        REQUIRE(after.allocations == before.allocations);
+        REQUIRE(after.shared_copies == before.shared_copies);
+    }
+    SECTION("Counters of exited threads are retained")
+    {
+        SStringStats::counters before = SStringStats::snapshot();
+
+        std::thread worker([]() {
+            SString a("one");
+            SString b("two");
+        });
+        worker.join();
+
+        SStringStats::counters after = SStringStats::snapshot();
+
+        REQUIRE(after.allocations - before.allocations == 2);
+        REQUIRE(after.frees - before.frees == 2);
+    }
+    SECTION("Padding allocates only the result")
+    {
+        SString str("cell\t");
+        SStringStats::counters before = SStringStats::snapshot();
+
+        SString padded = str.center(12);
+        SString truncated = str.truncate(10);
+        SString expanded = str.expandtabs();
+        SStringStats::counters after = SStringStats::snapshot();
+
+        REQUIRE(after.allocations - before.allocations == 3);
+    }
+}
+
+#else
+
+TEST_CASE("Statistics compiled out", "[SStringStats]")
+{
+    SString str("Hello");
+    SString copy(str);
+
+    SStringStats::counters stats = SStringStats::snapshot();
+
+    REQUIRE_FALSE(SStringStats::enabled());
+    REQUIRE(stats.allocations == 0);
+    REQUIRE(stats.shared_copies == 0);
+}
+
+#endif // SSTRING_ENABLE_STATS
+
+TEST_CASE("Dumping statistics as JSON", "[SStringStats]")
+{
+    SStringStats::counters stats = SStringStats::counters();
+    stats.allocations = 3;
+    stats.live_bytes = 48;
+    stats.length_histogram[2] = 3;
+
+    std::ostringstream json;
+    SStringStats::dump(json, stats);
+
+    REQUIRE(json.str().find("\"allocations\":3,") != std::string::npos);
+    REQUIRE(json.str().find("\"live_bytes\":48,") != std::string::npos);
+    REQUIRE(json.str().find("\"length_histogram\":[0,0,3]") != std::string::npos);
+    REQUIRE(json.str().find("\"ref_count_histogram\":[]") != std::string::npos);
+    REQUIRE(json.str().front() == '{');
+    REQUIRE(json.str().back() == '}');
+}
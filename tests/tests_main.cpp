@@ -13,4 +13,5 @@
 *******************************************************************************/
 
 #define CATCH_CONFIG_MAIN
+#define CATCH_CONFIG_NO_POSIX_SIGNALS // SIGSTKSZ is no longer constant in glibc >= 2.34
 #include "catch.hpp"
@@ -0,0 +1,117 @@
+/*
+File: trace_tests.cpp
+
+Copyright (c) 2018 Alexander DuPree
+
+This software is released as open source through the MIT License
+
+Authors: Alexander DuPree
+
+https://github.com/AlexanderJDupree/Python-Strings-for-CPP
+
+*/
+
+#include <sstream>
+#include "catch.hpp"
+#include "sstring.h"
+
+TEST_CASE("Latency histograms", "[SStringTrace], [histogram]")
+{
+    SECTION("Small values are counted exactly")
+    {
+        for (unsigned i = 0; i < 16; ++i)
+        {
+            REQUIRE(SStringTrace::histogram::bucket(i) == i);
+            REQUIRE(SStringTrace::histogram::lower_bound(i) == i);
+        }
+    }
+    SECTION("Buckets stay within 12.5% of their lower bound")
+    {
+        SStringTrace::tick_type values[] = { 16, 17, 31, 32, 1000, 123456789, 
+                                             ~0ull };
+        for (SStringTrace::tick_type value : values)
+        {
+            unsigned bucket = SStringTrace::histogram::bucket(value);
+            SStringTrace::tick_type lower = SStringTrace::histogram::lower_bound(bucket);
+
+            REQUIRE(bucket < SStringTrace::histogram::buckets);
+            REQUIRE(lower <= value);
+            REQUIRE(value - lower <= lower / 8);
+        }
+    }
+    SECTION("Percentiles")
+    {
+        SStringTrace::histogram h;
+        for (unsigned i = 1; i <= 10; ++i)
+        {
+            h.add(i);
+        }
+        h.add(1000, 90);
+
+        REQUIRE(h.count() == 100);
+        REQUIRE(h.percentile(5) == 5);
+        REQUIRE(h.percentile(50) == SStringTrace::histogram::lower_bound(
+                                        SStringTrace::histogram::bucket(1000)));
+    }
+}
+
+TEST_CASE("Trace dumps", "[SStringTrace], [report]")
+{
+    std::ostringstream out;
+    SStringTrace::dump(out);
+
+    std::istringstream in(out.str() + "strip 20 3\n");
+    SStringTrace::histogram histograms[SStringTrace::operation_count];
+    double ns_per_tick = 0;
+
+    REQUIRE(SStringTrace::load(in, histograms, ns_per_tick));
+    REQUIRE(ns_per_tick > 0);
+    REQUIRE(histograms[SStringTrace::strip].at(20) >= 3);
+
+    std::istringstream bad("sstring-trace 1 0.5\nunknown 1 1\n");
+    REQUIRE_FALSE(SStringTrace::load(bad, histograms, ns_per_tick));
+
+    std::ostringstream report;
+    SStringTrace::report(report, histograms, 1);
+    REQUIRE(report.str().find("strip") != std::string::npos);
+}
+
+#ifdef SSTRING_ENABLE_TRACE
+
+static unsigned hook_calls = 0;
+
+static void count_hook(SStringTrace::operation, SStringTrace::tick_type)
+{
+    ++hook_calls;
+}
+
+TEST_CASE("Sampling operation latency", "[SStringTrace]")
+{
+    SStringTrace::reset();
+    SStringTrace::set_sample_rate(1);
+    SStringTrace::set_hook(count_hook);
+    hook_calls = 0;
+
+    SString str("  traced  ");
+    SString sum = str + "more";
+    bool equal = sum == str;
+    str.strip(' ');
+    std::ostringstream out;
+    out << str;
+
+    SStringTrace::set_sample_rate(0);
+    SStringTrace::set_hook(NULL);
+
+    REQUIRE_FALSE(equal);
+    REQUIRE(SStringTrace::snapshot(SStringTrace::construct).count() >= 1);
+    REQUIRE(SStringTrace::snapshot(SStringTrace::concatenate).count() == 1);
+    REQUIRE(SStringTrace::snapshot(SStringTrace::compare).count() == 1);
+    REQUIRE(SStringTrace::snapshot(SStringTrace::strip).count() == 1);
+    REQUIRE(SStringTrace::snapshot(SStringTrace::stream_io).count() == 1);
+    REQUIRE(hook_calls >= 5);
+
+    SStringTrace::reset();
+    REQUIRE(SStringTrace::snapshot(SStringTrace::strip).count() == 0);
+}
+
+#endif // SSTRING_ENABLE_TRACE
@@ -0,0 +1,133 @@
+/*
+File: writer_tests.cpp
+
+Copyright (c) 2018 Alexander DuPree
+
+This software is released as open source through the MIT License
+
+Authors: Alexander DuPree
+
+https://github.com/AlexanderJDupree/Python-Strings-for-CPP
+
+*/
+
+#include <cstdio>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <tuple>
+#include <fcntl.h>
+#include <unistd.h>
+#include "catch.hpp"
+#include "sstring_writer.h"
+
+// Reads fd to end of file
+static std::string read_all(int fd)
+{
+    std::string result;
+    char buffer[4096];
+    ssize_t n;
+    while ((n = read(fd, buffer, sizeof(buffer))) > 0)
+    {
+        result.append(buffer, n);
+    }
+    REQUIRE(n == 0);
+    return result;
+}
+
+TEST_CASE("Writing strings to descriptors", "[SStringWriter]")
+{
+    int fds[2];
+    REQUIRE(pipe(fds) == 0);
+
+    SECTION("Strings are written in order when flushed")
+    {
+        SStringWriter writer(fds[1]);
+        writer << "first" << SString() << " second" << "\n"_ss;
+        writer.write("third");
+
+        REQUIRE(writer.pending() == 4);
+        writer.flush();
+        REQUIRE(writer.pending() == 0);
+        close(fds[1]);
+
+        REQUIRE(read_all(fds[0]) == "first second\nthird");
+    }
+    SECTION("A full batch is written")
+    {
+        SStringWriter writer(fds[1], 3);
+        writer << "a" << "b";
+        REQUIRE(writer.pending() == 2);
+        writer << "c";
+        REQUIRE(writer.pending() == 0);
+        writer << "d";
+        REQUIRE(writer.pending() == 1);
+
+        char buffer[4] = { 0 };
+        REQUIRE(read(fds[0], buffer, 3) == 3);
+        REQUIRE(std::string(buffer) == "abc");
+        writer.flush();
+        close(fds[1]);
+    }
+    SECTION("The destructor writes the gathered strings")
+    {
+        {
+            SStringWriter writer(fds[1]);
+            writer << "left" << " over";
+        }
+        close(fds[1]);
+
+        REQUIRE(read_all(fds[0]) == "left over");
+    }
+    SECTION("Gathered strings outlive their sources")
+    {
+        SStringWriter writer(fds[1]);
+        {
+            SString line("a line read into a chunk");
+            writer << std::get<2>(line.partition(" ")) << SString(3, '!');
+            REQUIRE(line.ref_count() == 2);
+        }
+        writer.flush();
+        close(fds[1]);
+
+        REQUIRE(read_all(fds[0]) == "line read into a chunk!!!");
+    }
+    SECTION("Short writes to a full pipe are resumed")
+    {
+        REQUIRE(fcntl(fds[1], F_SETFL, O_NONBLOCK) == 0);
+
+        std::string expected;
+        std::thread writing([&fds, &expected]() {
+            SStringWriter writer(fds[1], 5000);
+            for (unsigned i = 0; i < 20000; ++i)
+            {
+                SString str(i % 50 + 1, char('a' + i % 26));
+                writer << str;
+                expected.append(str.begin(), str.length());
+            }
+            writer.flush();
+            close(fds[1]);
+        });
+
+        std::string written = read_all(fds[0]);
+        writing.join();
+        REQUIRE(written.size() == expected.size());
+        REQUIRE(written == expected);
+    }
+    SECTION("Errors are thrown and drop the batch")
+    {
+        SStringWriter writer(fds[1]);
+        writer << "nobody reads this";
+        close(fds[1]);
+
+        REQUIRE_THROWS_AS(writer.flush(), std::system_error);
+        REQUIRE(writer.pending() == 0);
+    }
+
+    close(fds[0]);
+}
+
+TEST_CASE("Constructing writers", "[SStringWriter]")
+{
+    REQUIRE_THROWS_AS(SStringWriter(1, 0), std::invalid_argument);
+}
@@ -0,0 +1,72 @@
+/*
+File: trace_report.cpp
+
+Copyright (c) 2018 Alexander DuPree
+
+This software is released as open source through the MIT License
+
+Authors: Alexander DuPree
+
+https://github.com/AlexanderJDupree/Python-Strings-for-CPP
+
+Description: Prints the latency percentiles of a trace written with 
+             SStringTrace::dump(). Several dumps, for example one per process,
+             are merged into one report.
+
+Usage: trace_report [dump...]     reads stdin when no dump is given
+
+*/
+
+#include <fstream>
+#include <iostream>
+#include "sstring_trace.h"
+
+static bool merge(std::istream& in, const char* name,
+                  SStringTrace::histogram* total, double& ns_per_tick)
+{
+    SStringTrace::histogram histograms[SStringTrace::operation_count];
+    if (!SStringTrace::load(in, histograms, ns_per_tick))
+    {
+        std::cerr << "trace_report: " << name << " is not a trace dump\n";
+        return false;
+    }
+
+    // Histograms share their bucket layout, so lower bounds add exactly
+    for (unsigned op = 0; op < SStringTrace::operation_count; ++op)
+    {
+        for (unsigned i = 0; i < SStringTrace::histogram::buckets; ++i)
+        {
+            if (histograms[op].at(i))
+            {
+                total[op].add(SStringTrace::histogram::lower_bound(i),
+                              histograms[op].at(i));
+            }
+        }
+    }
+
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    SStringTrace::histogram total[SStringTrace::operation_count];
+    double ns_per_tick = 1;
+
+    if (argc < 2 && !merge(std::cin, "stdin", total, ns_per_tick))
+    {
+        return 1;
+    }
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::ifstream in(argv[i]);
+        if (!in || !merge(in, argv[i], total, ns_per_tick))
+        {
+            std::cerr << "trace_report: could not read " << argv[i] << '\n';
+            return 1;
+        }
+    }
+
+    SStringTrace::report(std::cout, total, ns_per_tick);
+    return 0;
+}